@@ -0,0 +1,46 @@
+//
+// Created for portable bit operations
+//
+
+#ifndef POKERSERVER_BITOPS_H
+#define POKERSERVER_BITOPS_H
+
+#include <cstdint>
+
+// 统计64位整数中1的个数
+inline int popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// 最低位1的位置，x不能为0
+inline int countTrailingZeros64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    return popcount64((x & (~x + 1)) - 1);
+#endif
+}
+
+// 最高位1之上0的个数，x不能为0
+inline int countLeadingZeros64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    x |= x >> 32;
+    return 64 - popcount64(x);
+#endif
+}
+
+#endif //POKERSERVER_BITOPS_H
@@ -0,0 +1,155 @@
+//
+// Created for self-play simulation
+//
+
+#include "BotPolicy.h"
+#include "BitOps.h"
+#include "HandStrength.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+BotAction look() { return BotAction{BotMove::LOOK, 0, -1}; }
+BotAction fold() { return BotAction{BotMove::FOLD, 0, -1}; }
+BotAction bet(int amount) { return BotAction{BotMove::BET, amount, -1}; }
+BotAction showdown(int target) { return BotAction{BotMove::SHOWDOWN, 0, target}; }
+
+// 编号最小的比牌对象
+int firstTarget(const LegalActions& legal) {
+    return countTrailingZeros64(legal.targets);
+}
+
+// 在比牌对象中均匀选一个：跳过前k个置位
+int randomTarget(const LegalActions& legal, Xoshiro256& rng) {
+    uint64_t rest = legal.targets;
+    for (uint32_t skip = uniformBelow(rng, static_cast<uint32_t>(popcount64(rest))); skip > 0; --skip) {
+        rest &= rest - 1;
+    }
+    return countTrailingZeros64(rest);
+}
+
+// 当前玩家自己的牌型，只在看牌之后使用
+CardType ownType(const TableState& state) {
+    if (state.strengthKeys) {
+        CardType type;
+        strengthKey(state.hands[state.current], type);
+        return type;
+    }
+    return strengthType(state.strength[state.current]);
+}
+
+// 机器人每次至少下注一个入场费：规则允许蒙牌只跟一半，全跟最小额时注额会越来越小，牌局拖不完
+int baseBet(const TableState& state) {
+    return min(max(state.legal.minBet, state.fee), state.legal.maxBet);
+}
+
+// 当前玩家本局已下注的金额是入场费的几倍
+int stakeInFees(const TableState& state) {
+    return state.totalBet[state.current] / state.fee;
+}
+
+// 随机：偶尔看牌，少量弃牌和比牌，其余在基本注额到两倍之间随机下注
+class RandomBot : public BotPolicy {
+public:
+    const char* name() const override { return "random"; }
+    BotAction decide(const TableState& state, Xoshiro256& rng) const override {
+        const LegalActions& legal = state.legal;
+        if (legal.canLook && uniformBelow(rng, 4) == 0) {
+            return look();
+        }
+        uint32_t roll = uniformBelow(rng, 100);
+        if (roll < 10) {
+            return fold();
+        }
+        if (roll < 30 && legal.canShowdown) {
+            return showdown(randomTarget(legal, rng));
+        }
+        int base = baseBet(state);
+        int span = min(legal.maxBet - base, base);
+        return bet(base + static_cast<int>(uniformBelow(rng, static_cast<uint32_t>(span) + 1)));
+    }
+};
+
+// 蒙牌到底：从不看牌，下基本注额，下注到入场费的8倍后找人比牌
+class BlindBot : public BotPolicy {
+public:
+    const char* name() const override { return "blind"; }
+    BotAction decide(const TableState& state, Xoshiro256&) const override {
+        const LegalActions& legal = state.legal;
+        if (stakeInFees(state) >= 8 && legal.canShowdown) {
+            return showdown(firstTarget(legal));
+        }
+        return bet(baseBet(state));
+    }
+};
+
+// 紧：先看牌，单张和235直接弃牌；对子下注到4倍入场费后比牌，顺子以上加倍下注到16倍后比牌
+class TightBot : public BotPolicy {
+public:
+    const char* name() const override { return "tight"; }
+    BotAction decide(const TableState& state, Xoshiro256&) const override {
+        const LegalActions& legal = state.legal;
+        if (legal.canLook) {
+            return look();
+        }
+        CardType type = ownType(state);
+        if (type == CardType::HIGH_CARD || type == CardType::SPECIAL_235) {
+            return fold();
+        }
+        bool strong = type != CardType::PAIR;
+        if (stakeInFees(state) >= (strong ? 16 : 4) && legal.canShowdown) {
+            return showdown(firstTarget(legal));
+        }
+        int base = baseBet(state);
+        return bet(strong ? min(base * 2, legal.maxBet) : base);
+    }
+};
+
+// 跟注：看牌后一直下基本注额，只剩两人且下注到10倍入场费后比牌
+class CallingBot : public BotPolicy {
+public:
+    const char* name() const override { return "calling"; }
+    BotAction decide(const TableState& state, Xoshiro256&) const override {
+        const LegalActions& legal = state.legal;
+        if (legal.canLook) {
+            return look();
+        }
+        if (state.activeCount() == 2 && stakeInFees(state) >= 10 && legal.canShowdown) {
+            return showdown(firstTarget(legal));
+        }
+        return bet(baseBet(state));
+    }
+};
+
+} // namespace
+
+unique_ptr<BotPolicy> makeBotPolicy(const string& name) {
+    if (name == "random") {
+        return unique_ptr<BotPolicy>(new RandomBot());
+    }
+    if (name == "blind") {
+        return unique_ptr<BotPolicy>(new BlindBot());
+    }
+    if (name == "tight") {
+        return unique_ptr<BotPolicy>(new TightBot());
+    }
+    if (name == "calling") {
+        return unique_ptr<BotPolicy>(new CallingBot());
+    }
+    throw invalid_argument("Unknown bot policy: " + name);
+}
+
+vector<string> botPolicyNames() {
+    return {"random", "blind", "tight", "calling"};
+}
+
+ActionStatus applyBotAction(TableState& state, const BotAction& action, ShowdownOutcome& outcome) {
+    switch (action.move) {
+        case BotMove::LOOK: return state.look();
+        case BotMove::BET: return state.bet(action.amount);
+        case BotMove::FOLD: return state.fold();
+        case BotMove::SHOWDOWN: return state.showdown(action.target, outcome);
+    }
+    return ActionStatus::INVALID_ACTION;
+}
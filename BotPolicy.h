@@ -0,0 +1,48 @@
+//
+// Created for self-play simulation
+// 机器人策略：模拟器按名称创建，每个座位一个策略
+//
+
+#ifndef POKERSERVER_BOTPOLICY_H
+#define POKERSERVER_BOTPOLICY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Rng.h"
+#include "TableState.h"
+
+using namespace std;
+
+// 机器人的操作种类，与TableState的四种操作对应
+enum class BotMove {
+    LOOK,
+    BET,
+    FOLD,
+    SHOWDOWN
+};
+
+struct BotAction {
+    BotMove move;
+    int amount;   // BET的金额
+    int target;   // SHOWDOWN的对象座位
+};
+
+// 机器人策略：为轮到的玩家state.current选择一个操作
+// 只能读取公开的信息（下注、状态、余额）和看牌之后自己的手牌；策略没有内部状态，可被多个线程共用
+class BotPolicy {
+public:
+    virtual ~BotPolicy() = default;
+    virtual const char* name() const = 0;
+    virtual BotAction decide(const TableState& state, Xoshiro256& rng) const = 0;
+};
+
+// 按名称创建策略，名称不存在时抛出invalid_argument
+unique_ptr<BotPolicy> makeBotPolicy(const string& name);
+// 所有策略的名称
+vector<string> botPolicyNames();
+
+// 执行机器人的操作；比牌时写入outcome
+ActionStatus applyBotAction(TableState& state, const BotAction& action, ShowdownOutcome& outcome);
+
+#endif //POKERSERVER_BOTPOLICY_H
@@ -4,7 +4,7 @@
 
 #include "Card.h"
 #include <sstream>
-#include <algorithm>
+#include <stdexcept>
 
 // 初始化静态成员变量
 const map<string, Rank> Card::rankMap = Card::initRankMap();
@@ -39,9 +39,6 @@ map<string, Suit> Card::initSuitMap() {
     return m;
 }
 
-// 构造函数
-Card::Card(Rank rank, Suit suit) : rank(rank), suit(suit) {}
-
 // 从字符串构造卡牌
 Card::Card(const string& cardStr) {
     size_t pos = cardStr.find(" of ");
@@ -53,8 +50,7 @@ Card::Card(const string& cardStr) {
         auto suitIt = suitMap.find(suitStr);
         
         if (rankIt != rankMap.end() && suitIt != suitMap.end()) {
-            rank = rankIt->second;
-            suit = suitIt->second;
+            *this = Card(rankIt->second, suitIt->second);
         } else {
             throw invalid_argument("Invalid card string: " + cardStr);
         }
@@ -66,16 +62,16 @@ Card::Card(const string& cardStr) {
 // 获取牌面的字符串表示
 string Card::toString() const {
     string rankStr;
-    switch (rank) {
+    switch (getRank()) {
         case Rank::ACE: rankStr = "A"; break;
         case Rank::KING: rankStr = "K"; break;
         case Rank::QUEEN: rankStr = "Q"; break;
         case Rank::JACK: rankStr = "J"; break;
-        default: rankStr = to_string(static_cast<int>(rank));
+        default: rankStr = to_string(static_cast<int>(getRank()));
     }
     
     string suitStr;
-    switch (suit) {
+    switch (getSuit()) {
         case Suit::HEARTS: suitStr = "Hearts"; break;
         case Suit::SPADES: suitStr = "Spades"; break;
         case Suit::DIAMONDS: suitStr = "Diamonds"; break;
@@ -88,16 +84,16 @@ string Card::toString() const {
 // 获取图片文件名
 string Card::getImageFileName() const {
     string rankStr;
-    switch (rank) {
+    switch (getRank()) {
         case Rank::ACE: rankStr = "A"; break;
         case Rank::KING: rankStr = "K"; break;
         case Rank::QUEEN: rankStr = "Q"; break;
         case Rank::JACK: rankStr = "J"; break;
-        default: rankStr = to_string(static_cast<int>(rank));
+        default: rankStr = to_string(static_cast<int>(getRank()));
     }
     
     string suitStr;
-    switch (suit) {
+    switch (getSuit()) {
         case Suit::HEARTS: suitStr = "Heart"; break;
         case Suit::SPADES: suitStr = "Spade"; break;
         case Suit::DIAMONDS: suitStr = "Diamond"; break;
@@ -109,70 +105,38 @@ string Card::getImageFileName() const {
 
 // 比较运算符重载
 bool Card::operator<(const Card& other) const {
-    if (rank != other.rank) {
-        return static_cast<int>(rank) < static_cast<int>(other.rank);
+    if (getRank() != other.getRank()) {
+        return static_cast<int>(getRank()) < static_cast<int>(other.getRank());
     }
-    return static_cast<int>(suit) > static_cast<int>(other.suit); // 注意这里是反向的，因为HEARTS是最大的
-}
-
-bool Card::operator==(const Card& other) const {
-    return rank == other.rank && suit == other.suit;
+    return static_cast<int>(getSuit()) > static_cast<int>(other.getSuit()); // 注意这里是反向的，因为HEARTS是最大的
 }
 
 // 判断是否为顺子
 bool Card::isStraight(const vector<Card>& cards) {
     if (cards.size() != 3) return false;
-    
-    vector<int> ranks;
-    for (const auto& card : cards) {
-        ranks.push_back(static_cast<int>(card.getRank()));
-    }
-    sort(ranks.begin(), ranks.end());
-    
-    // 处理特殊情况：A23
-    if (ranks[0] == static_cast<int>(Rank::TWO) &&
-        ranks[1] == static_cast<int>(Rank::THREE) &&
-        ranks[2] == static_cast<int>(Rank::ACE)) {
-        return true;
-    }
-    
-    // 普通顺子
-    return ranks[2] - ranks[1] == 1 && ranks[1] - ranks[0] == 1;
+    return isStraight(Hand{cards[0], cards[1], cards[2]});
 }
 
 // 判断是否为同花
 bool Card::isFlush(const vector<Card>& cards) {
     if (cards.size() != 3) return false;
-    return cards[0].getSuit() == cards[1].getSuit() &&
-           cards[1].getSuit() == cards[2].getSuit();
+    return isFlush(Hand{cards[0], cards[1], cards[2]});
 }
 
 // 判断是否为豹子
 bool Card::isThreeOfAKind(const vector<Card>& cards) {
     if (cards.size() != 3) return false;
-    return cards[0].getRank() == cards[1].getRank() &&
-           cards[1].getRank() == cards[2].getRank();
+    return isThreeOfAKind(Hand{cards[0], cards[1], cards[2]});
 }
 
 // 判断是否为对子
 bool Card::isPair(const vector<Card>& cards) {
     if (cards.size() != 3) return false;
-    return (cards[0].getRank() == cards[1].getRank() && cards[1].getRank() != cards[2].getRank()) ||
-           (cards[1].getRank() == cards[2].getRank() && cards[0].getRank() != cards[1].getRank()) ||
-           (cards[0].getRank() == cards[2].getRank() && cards[0].getRank() != cards[1].getRank());
+    return isPair(Hand{cards[0], cards[1], cards[2]});
 }
 
 // 判断是否为特殊235
 bool Card::isSpecial235(const vector<Card>& cards) {
     if (cards.size() != 3) return false;
-    
-    vector<int> ranks;
-    for (const auto& card : cards) {
-        ranks.push_back(static_cast<int>(card.getRank()));
-    }
-    sort(ranks.begin(), ranks.end());
-    
-    return ranks[0] == static_cast<int>(Rank::TWO) &&
-           ranks[1] == static_cast<int>(Rank::THREE) &&
-           ranks[2] == static_cast<int>(Rank::FIVE);
-}
\ No newline at end of file
+    return isSpecial235(Hand{cards[0], cards[1], cards[2]});
+}
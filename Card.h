@@ -8,6 +8,9 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <array>
+#include <cstdint>
+#include <type_traits>
 
 using namespace std;
 
@@ -25,16 +28,30 @@ enum class Rank {
     JACK, QUEEN, KING, ACE
 };
 
+class Card;
+
+// 一手牌：三张牌，共3字节，从发牌一直传递到比牌和显示
+using Hand = array<Card, 3>;
+
+// 扑克牌：点数和花色打包在一个字节的低6位中（点数<<2 | 花色），可平凡复制
 class Card {
 public:
-    Card() : rank(Rank::TWO), suit(Suit::CLUBS) {} // 默认构造函数
-    Card(Rank rank, Suit suit);
-    Card(const string& cardStr); // 从字符串构造卡牌
+    constexpr Card() : code(static_cast<uint8_t>(static_cast<int>(Rank::TWO) << 2 | static_cast<int>(Suit::CLUBS))) {} // 默认构造函数
+    constexpr Card(Rank rank, Suit suit)
+        : code(static_cast<uint8_t>(static_cast<int>(rank) << 2 | static_cast<int>(suit))) {}
+    explicit Card(const string& cardStr); // 从字符串构造卡牌，仅用于解析外部输入
     
-    Rank getRank() const { return rank; }
-    Suit getSuit() const { return suit; }
+    constexpr Rank getRank() const { return static_cast<Rank>(code >> 2); }
+    constexpr Suit getSuit() const { return static_cast<Suit>(code & 3); }
     
-    // 获取牌面的字符串表示
+    // 获取牌的下标：(点数-2)*4+花色，范围[0, 52)
+    constexpr int index() const { return code - (static_cast<int>(Rank::TWO) << 2); }
+    // 由下标构造卡牌
+    static constexpr Card fromIndex(int index) {
+        return Card(static_cast<Rank>(index / 4 + static_cast<int>(Rank::TWO)), static_cast<Suit>(index % 4));
+    }
+    
+    // 获取牌面的字符串表示（仅用于显示和日志）
     string toString() const;
     
     // 获取图片文件名
@@ -42,7 +59,8 @@ public:
     
     // 比较运算符重载
     bool operator<(const Card& other) const;
-    bool operator==(const Card& other) const;
+    constexpr bool operator==(const Card& other) const { return code == other.code; }
+    constexpr bool operator!=(const Card& other) const { return code != other.code; }
     
     // 静态方法：判断是否为顺子
     static bool isStraight(const vector<Card>& cards);
@@ -55,9 +73,26 @@ public:
     // 静态方法：判断是否为特殊235
     static bool isSpecial235(const vector<Card>& cards);
     
+    // 无分配版本：直接作用于固定三张牌，顺子用点数位掩码判断（含A23）
+    static constexpr bool isStraight(const Hand& cards);
+    static constexpr bool isFlush(const Hand& cards);
+    static constexpr bool isThreeOfAKind(const Hand& cards);
+    static constexpr bool isPair(const Hand& cards);
+    static constexpr bool isSpecial235(const Hand& cards);
+    
+    // 三元素排序网络：按operator<的顺序升序排列，无数据相关分支
+    static constexpr Hand sortHand(const Hand& cards);
+    // 三张牌的点数位掩码：第点数位表示该点数出现
+    static constexpr unsigned rankMask(const Hand& cards);
+    
 private:
-    Rank rank;
-    Suit suit;
+    uint8_t code; // 点数<<2 | 花色
+    
+    static constexpr Card fromCode(int code) {
+        Card card;
+        card.code = static_cast<uint8_t>(code);
+        return card;
+    }
     
     // 静态映射表：用于字符串转换
     static const map<string, Rank> rankMap;
@@ -68,4 +103,52 @@ private:
     static map<string, Suit> initSuitMap();
 };
 
+static_assert(sizeof(Card) == 1, "Card must fit in one byte");
+static_assert(is_trivially_copyable<Card>::value, "Card must be trivially copyable");
+
+inline constexpr unsigned Card::rankMask(const Hand& cards) {
+    return (1u << (cards[0].code >> 2)) | (1u << (cards[1].code >> 2)) | (1u << (cards[2].code >> 2));
+}
+
+// 三个不同且相邻的点数在掩码中是连续的三位；A23单独匹配
+inline constexpr bool Card::isStraight(const Hand& cards) {
+    unsigned mask = rankMask(cards);
+    unsigned lowest = mask & (~mask + 1);
+    const unsigned a23 = (1u << static_cast<int>(Rank::ACE)) | (1u << static_cast<int>(Rank::TWO)) |
+                         (1u << static_cast<int>(Rank::THREE));
+    return (mask == lowest * 7) | (mask == a23);
+}
+
+inline constexpr bool Card::isFlush(const Hand& cards) {
+    return ((cards[0].code & 3) == (cards[1].code & 3)) & ((cards[1].code & 3) == (cards[2].code & 3));
+}
+
+inline constexpr bool Card::isThreeOfAKind(const Hand& cards) {
+    return ((cards[0].code >> 2) == (cards[1].code >> 2)) & ((cards[1].code >> 2) == (cards[2].code >> 2));
+}
+
+// 恰好两种点数即为对子
+inline constexpr bool Card::isPair(const Hand& cards) {
+    unsigned mask = rankMask(cards);
+    unsigned rest = mask & (mask - 1);
+    return (rest != 0) & ((rest & (rest - 1)) == 0);
+}
+
+inline constexpr bool Card::isSpecial235(const Hand& cards) {
+    return rankMask(cards) == ((1u << static_cast<int>(Rank::TWO)) | (1u << static_cast<int>(Rank::THREE)) |
+                               (1u << static_cast<int>(Rank::FIVE)));
+}
+
+// 排序值取 code ^ 3：点数在高位，低2位为 3-花色，升序即operator<的顺序
+inline constexpr Hand Card::sortHand(const Hand& cards) {
+    int a = cards[0].code ^ 3, b = cards[1].code ^ 3, c = cards[2].code ^ 3;
+    int lo = a < b ? a : b, hi = a < b ? b : a;
+    a = lo; b = hi;
+    lo = b < c ? b : c; hi = b < c ? c : b;
+    b = lo; c = hi;
+    lo = a < b ? a : b; hi = a < b ? b : a;
+    a = lo; b = hi;
+    return Hand{fromCode(a ^ 3), fromCode(b ^ 3), fromCode(c ^ 3)};
+}
+
 #endif //POKERSERVER_CARD_H
\ No newline at end of file
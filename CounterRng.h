@@ -0,0 +1,93 @@
+//
+// Created for counter-based random streams
+//
+
+#ifndef POKERSERVER_COUNTERRNG_H
+#define POKERSERVER_COUNTERRNG_H
+
+#include <array>
+#include <cstdint>
+
+using namespace std;
+
+// Philox4x32-10：把(计数器, 密钥)直接映射为128位随机数，无内部状态，
+// 不同的流只需不同的计数器高位，任意拆分到多线程都不会重叠
+inline array<uint32_t, 4> philox4x32(array<uint32_t, 4> counter, array<uint32_t, 2> key) {
+    const uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+    const uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = static_cast<uint64_t>(M0) * counter[0];
+        uint64_t p1 = static_cast<uint64_t>(M1) * counter[2];
+        counter = {static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(p1),
+                   static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(p0)};
+        key[0] += W0;
+        key[1] += W1;
+    }
+    return counter;
+}
+
+// 基于Philox的随机流：元组(种子, 牌桌, 牌局, 抽取序号)直接映射为随机位，没有需要传递的状态
+// 密钥为种子；计数器第0字为块序号（每块4次抽取），第1字为牌桌编号，第2、3字为牌局编号
+// 块序号超过2^32时进位到第1字，即单个牌局最多抽取2^34次才会与下一张牌桌的流重叠
+// 任何线程或进程只要知道元组就能独立算出同样的结果，与工作单元的划分方式无关
+class CounterRng {
+public:
+    // 满足UniformRandomBitGenerator，可直接用于Deck::deal和uniformBelow（均匀整数只由uniformBelow实现）
+    using result_type = uint32_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    CounterRng(uint64_t seed, uint32_t table, uint64_t hand)
+        : key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          table(table), hand(hand), block(0), used(4) {}
+    // 单一编号的流：等价于牌桌0上编号为stream的牌局
+    CounterRng(uint64_t seed, uint64_t stream) : CounterRng(seed, 0, stream) {}
+
+    // 不经过前面的抽取，直接算出元组对应的32位随机数
+    static uint32_t at(uint64_t seed, uint32_t table, uint64_t hand, uint64_t draw) {
+        CounterRng rng(seed, table, hand);
+        rng.seek(draw);
+        return rng.next32();
+    }
+
+    // 跳到第draw次抽取
+    void seek(uint64_t draw) {
+        block = draw / 4;
+        used = 4;
+        if (draw % 4 != 0) {
+            refill();
+            used = static_cast<int>(draw % 4);
+        }
+    }
+
+    uint32_t next32() {
+        if (used == 4) {
+            refill();
+        }
+        return buffer[used++];
+    }
+
+    result_type operator()() { return next32(); }
+
+    uint64_t next64() {
+        uint64_t high = next32();
+        return high << 32 | next32();
+    }
+
+private:
+    array<uint32_t, 2> key;
+    uint32_t table;
+    uint64_t hand;
+    uint64_t block;
+    array<uint32_t, 4> buffer;
+    int used;
+
+    void refill() {
+        buffer = philox4x32({static_cast<uint32_t>(block), table + static_cast<uint32_t>(block >> 32),
+                             static_cast<uint32_t>(hand), static_cast<uint32_t>(hand >> 32)}, key);
+        ++block;
+        used = 0;
+    }
+};
+
+#endif //POKERSERVER_COUNTERRNG_H
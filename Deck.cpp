@@ -0,0 +1,158 @@
+//
+// Created for bitmask deck engine
+//
+
+#include "Deck.h"
+#include "BitOps.h"
+#include "EntropyPool.h"
+#include <algorithm>
+#include <string>
+
+namespace {
+
+// 从前往后的部分Fisher-Yates，rng为32位输出的引擎
+// 第i个位置只取决于前i+1次抽取，所以只洗前depth个位置时这些位置与完整洗牌相同
+template <typename Rng>
+void shuffleOrder(Rng& rng, array<uint8_t, DECK_SIZE>& order, int depth) {
+    for (int i = 0; i < DECK_SIZE; ++i) {
+        order[i] = static_cast<uint8_t>(i);
+    }
+    int last = min(depth, DECK_SIZE - 1);
+    for (int i = 0; i < last; ++i) {
+        int j = i + static_cast<int>(uniformBelow(rng, static_cast<uint32_t>(DECK_SIZE - i)));
+        uint8_t t = order[i]; order[i] = order[j]; order[j] = t;
+    }
+}
+
+// 64位引擎每次输出拆成两个32位字使用
+template <typename Engine>
+void shuffleWith(Engine engine, array<uint8_t, DECK_SIZE>& order, int depth) {
+    HalfWords<Engine> words(engine);
+    shuffleOrder(words, order, depth);
+}
+
+} // namespace
+
+/**
+ * 由种子洗出一副牌 - 只构造选中的引擎，完整洗一次约需3个ChaCha20分组
+ * @param engine 牌桌使用的随机数引擎，回放时必须相同
+ * @param seed 牌桌种子和牌局编号
+ * @param depth 需要确定的位置数，发牌时取Deck::shuffleDepth，预洗牌池和公平性检验取DECK_SIZE
+ * @return 洗好的牌，附带种子
+ */
+ShuffledDeck ShuffledDeck::fromSeed(RngEngine engine, const DealSeed& seed, int depth) {
+    ShuffledDeck deck = ShuffledDeck();
+    deck.seed = seed;
+    switch (engine) {
+        case RngEngine::PCG64:
+            shuffleWith(Pcg64(seed.tableSeed, seed.handNumber), deck.order, depth);
+            break;
+        case RngEngine::CHACHA20:
+            shuffleWith(ChaCha20Rng::fromInsecureSeed(seed.tableSeed, seed.handNumber), deck.order, depth);
+            break;
+        case RngEngine::PHILOX: {
+            CounterRng rng(seed.tableSeed, seed.handNumber);  // 本身就是32位输出
+            shuffleOrder(rng, deck.order, depth);
+            break;
+        }
+        default:
+            shuffleWith(Xoshiro256(seed.tableSeed, seed.handNumber), deck.order, depth);
+            break;
+    }
+    return deck;
+}
+
+/**
+ * 以256位密钥洗出一副牌 - 真钱牌桌每局一个新密钥，单局密钥泄露不会暴露其他牌局
+ * @param key 本局的密钥，应来自DealKey::fromEntropy
+ * @param seed 牌桌种子和牌局编号，牌局编号作为ChaCha20的流编号
+ * @param depth 需要确定的位置数，与fromSeed相同
+ * @return 洗好的牌，附带种子和密钥
+ */
+ShuffledDeck ShuffledDeck::fromKey(const DealKey& key, const DealSeed& seed, int depth) {
+    ShuffledDeck deck = ShuffledDeck();
+    deck.seed = seed;
+    deck.key = key;
+    deck.keyed = true;
+    shuffleWith(ChaCha20Rng(key.words, seed.handNumber), deck.order, depth);
+    return deck;
+}
+
+DealKey DealKey::fromEntropy() {
+    DealKey key;
+    EntropyPool::local().read(key.words.data(), sizeof(key.words));
+    return key;
+}
+
+int Deck::size() const {
+    return popcount64(remaining);
+}
+
+vector<Card> Deck::cards() const {
+    uint8_t buffer[DECK_SIZE];
+    int count = collect(buffer);
+    vector<Card> result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        result.push_back(Card::fromIndex(buffer[i]));
+    }
+    return result;
+}
+
+/**
+ * 把剩余的牌展开到数组 - 每次取最低位，只循环剩余张数次
+ * @param cards 输出数组，至少DECK_SIZE个元素
+ * @return 剩余张数
+ */
+int Deck::collect(uint8_t* cards) const {
+    int count = 0;
+    for (uint64_t rest = remaining; rest; rest &= rest - 1) {
+        cards[count++] = static_cast<uint8_t>(countTrailingZeros64(rest));
+    }
+    return count;
+}
+
+DealStatus Deck::dealStatus(int numHands) const {
+    if (numHands <= 0) {
+        return DealStatus::INVALID_PLAYER_COUNT;
+    }
+    if (numHands > size() / 3) {
+        return DealStatus::NOT_ENOUGH_CARDS;
+    }
+    return DealStatus::OK;
+}
+
+/**
+ * 校验发牌人数
+ * @param numHands 要发的手数
+ */
+void Deck::checkDeal(int numHands) const {
+    DealStatus status = dealStatus(numHands);
+    if (status == DealStatus::INVALID_PLAYER_COUNT) {
+        throw invalid_argument("Number of players must be a positive integer.");
+    }
+    if (status == DealStatus::NOT_ENOUGH_CARDS) {
+        throw invalid_argument("Too many players! Maximum players allowed is " + to_string(size() / 3) + ".");
+    }
+}
+
+/**
+ * 按预先洗好的顺序发牌
+ * @param numHands 要发的手数
+ * @param hands 输出，第k张有效的牌发给第k%numHands名玩家
+ * @param shuffled 预先洗好的一副牌
+ */
+void Deck::dealFrom(int numHands, Hand* hands, const ShuffledDeck& shuffled) {
+    checkDeal(numHands);
+    int needed = 3 * numHands;
+    int dealt = 0;
+    for (int i = 0; dealt < needed; ++i) {
+        int card = shuffled.order[i];
+        if ((remaining >> card & 1) == 0) {
+            continue;
+        }
+        hands[dealt % numHands][dealt / numHands] = Card::fromIndex(card);
+        remaining &= ~(1ULL << card);
+        ++dealt;
+    }
+}
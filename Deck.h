@@ -0,0 +1,139 @@
+//
+// Created for bitmask deck engine
+//
+
+#ifndef POKERSERVER_DECK_H
+#define POKERSERVER_DECK_H
+
+#include "Card.h"
+#include "HandIndex.h"
+#include "Rng.h"
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+// 一副牌的张数
+const int DECK_SIZE = 52;
+// 一副牌最多能发的手数：52 / 3
+const int MAX_DEAL_HANDS = DECK_SIZE / 3;
+// 完整一副牌的掩码：第index()位表示该牌仍在牌堆中
+const uint64_t FULL_DECK_MASK = (1ULL << DECK_SIZE) - 1;
+
+// 发牌结果：不抛异常的发牌接口用它报告错误
+enum class DealStatus {
+    OK,
+    INVALID_PLAYER_COUNT,  // 人数不是正数
+    NOT_ENOUGH_CARDS,      // 剩余的牌不够发这么多人
+    BUFFER_TOO_SMALL       // 调用方提供的缓冲区放不下
+};
+
+// 一副牌的种子：牌桌种子加牌局编号，共16字节，随每手牌记录即可完整复现发牌
+struct DealSeed {
+    uint64_t tableSeed;
+    uint64_t handNumber;
+};
+static_assert(sizeof(DealSeed) == 16, "deal seed must stay 16 bytes");
+
+// 真钱牌桌一局的ChaCha20密钥：8个字全部取自系统熵源，不由任何64位种子扩展
+// 这样的一局由(密钥, 牌局编号)洗牌，DealSeed只用作记录编号，回放时还需要密钥本身
+struct DealKey {
+    array<uint32_t, 8> words;
+
+    static DealKey fromEntropy(); // 从本线程的EntropyPool读取32字节
+};
+
+// 预先洗好的一整副牌：52张牌下标的一个随机排列，及生成它的种子
+struct ShuffledDeck {
+    array<uint8_t, DECK_SIZE> order;
+    DealSeed seed;
+    DealKey key;   // keyed为true时洗牌所用的密钥，否则全零
+    bool keyed;    // 由fromKey洗出，回放需要key
+
+    // 由种子确定性地洗出一副牌：随机流为(牌桌种子, 牌局编号)，从前往后做Fisher-Yates
+    // 只确定前depth个位置，其后的牌未打乱；前depth张与完整洗牌（depth为DECK_SIZE）的前depth张相同
+    // 也是回放接口：同样的引擎和种子总是得到同样的牌序，审计时不必保存整副牌
+    // CHACHA20的密钥由种子扩展而来，只有64位熵，只用于模拟、测试和固定种子的牌桌
+    static ShuffledDeck fromSeed(RngEngine engine, const DealSeed& seed, int depth = DECK_SIZE);
+    // 真钱牌桌的洗牌：ChaCha20以256位密钥播种，流编号为牌局编号，其余与fromSeed相同
+    static ShuffledDeck fromKey(const DealKey& key, const DealSeed& seed, int depth = DECK_SIZE);
+};
+
+// 位掩码牌堆：剩余的牌只用一个64位整数表示，不分配内存
+// 不预先洗整副牌，发牌时只对需要的3×N张做部分Fisher-Yates
+class Deck {
+public:
+    Deck() : remaining(FULL_DECK_MASK) {}
+
+    void reset() { remaining = FULL_DECK_MASK; } // 收回所有牌
+
+    // 移除已知的牌（例如胜率计算中已经亮出的手牌），已不在牌堆中的牌忽略
+    void removeCards(uint64_t mask) { remaining &= ~mask; }
+    void removeCard(const Card& card) { removeCards(1ULL << card.index()); }
+    void removeHand(const Hand& hand) { removeCards(handMask(hand)); }
+
+    bool contains(const Card& card) const { return (remaining >> card.index() & 1) != 0; }
+    uint64_t mask() const { return remaining; }
+    int size() const;
+
+    // 剩余的牌，按下标从小到大排列（用于调试输出）
+    vector<Card> cards() const;
+
+    // 检查能否发numHands手牌
+    DealStatus dealStatus(int numHands) const;
+    // 同上，不能发时抛出invalid_argument
+    void checkDeal(int numHands) const;
+
+    // 随机发numHands手牌到hands，发出的牌从牌堆移除；剩余的牌不够时抛出invalid_argument
+    // rng为任意输出至少32位的均匀随机数引擎（如TableRng）
+    template <typename Rng>
+    void deal(int numHands, Hand* hands, Rng& rng);
+
+    // 按预先洗好的顺序发牌：跳过已不在牌堆中的牌，其余与deal相同
+    // 均匀排列限制到剩余的牌上仍是均匀排列，因此部分发过牌的牌堆也可以使用
+    void dealFrom(int numHands, Hand* hands, const ShuffledDeck& shuffled);
+    // dealFrom发numHands手牌最多读到洗好的牌的第几个位置：3×N张加上可能被跳过的已发出的牌
+    // 以此作为fromSeed的depth，发出的牌与完整洗牌时完全相同
+    int shuffleDepth(int numHands) const { return 3 * numHands + DECK_SIZE - size(); }
+
+    // 随机抽一张牌并从牌堆移除
+    template <typename Rng>
+    Card draw(Rng& rng);
+
+private:
+    uint64_t remaining;
+
+    int collect(uint8_t* cards) const; // 把剩余的牌展开到数组，返回张数
+};
+
+template <typename Rng>
+void Deck::deal(int numHands, Hand* hands, Rng& rng) {
+    checkDeal(numHands);
+    uint8_t cards[DECK_SIZE];
+    int count = collect(cards);
+
+    // 部分Fisher-Yates：只确定前3×N个位置，第k张牌发给第k%N名玩家，与逐张轮流发牌一致
+    int needed = 3 * numHands;
+    for (int i = 0; i < needed; ++i) {
+        int j = i + static_cast<int>(uniformBelow(rng, static_cast<uint32_t>(count - i)));
+        uint8_t t = cards[i]; cards[i] = cards[j]; cards[j] = t;
+        hands[i % numHands][i / numHands] = Card::fromIndex(cards[i]);
+        remaining &= ~(1ULL << cards[i]);
+    }
+}
+
+template <typename Rng>
+Card Deck::draw(Rng& rng) {
+    uint8_t cards[DECK_SIZE];
+    int count = collect(cards);
+    if (count == 0) {
+        throw invalid_argument("Deck is empty.");
+    }
+    int card = cards[uniformBelow(rng, static_cast<uint32_t>(count))];
+    remaining &= ~(1ULL << card);
+    return Card::fromIndex(card);
+}
+
+#endif //POKERSERVER_DECK_H
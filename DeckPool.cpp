@@ -0,0 +1,87 @@
+//
+// Created for pre-shuffled deck pool
+// 游戏线程出队不加锁；只有后台线程在休眠、且队列降到一半以下时，出队的线程才短暂持锁唤醒它
+//
+
+#include "DeckPool.h"
+
+DeckPool::DeckPool(RngEngine engine, size_t capacity)
+    : DeckPool(engine, capacity, entropySeed(), 0, engine == RngEngine::CHACHA20) {
+}
+
+DeckPool::DeckPool(RngEngine engine, size_t capacity, uint64_t tableSeed, uint64_t firstHand)
+    : DeckPool(engine, capacity, tableSeed, firstHand, false) {
+}
+
+DeckPool::DeckPool(RngEngine engine, size_t capacity, uint64_t tableSeed, uint64_t firstHand, bool secureKeys)
+    : kind(engine), ring(capacity), lowWater(capacity / 2),
+      refillerSleeping(false), stopping(false), fallbacks(0), seed(tableSeed), nextHand(firstHand), secureKeys(secureKeys) {
+    refiller = thread(&DeckPool::refillLoop, this);
+}
+
+DeckPool::~DeckPool() {
+    {
+        lock_guard<mutex> guard(wakeLock);
+        stopping.store(true, memory_order_relaxed);
+    }
+    wake.notify_one();
+    refiller.join();
+}
+
+bool DeckPool::tryPop(ShuffledDeck& deck) {
+    if (!ring.tryPop(deck)) {
+        return false;
+    }
+    wakeRefiller();
+    return true;
+}
+
+/**
+ * 出队后检查是否需要唤醒后台线程 - 它没有休眠或队列还有一半以上时不碰锁
+ * 与refillLoop各有一道seq_cst栅栏：要么这里看到休眠标志，要么后台线程在休眠前看到这次出队
+ */
+void DeckPool::wakeRefiller() {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (!refillerSleeping.load(memory_order_relaxed) || ring.approximateSize() >= lowWater) {
+        return;
+    }
+    {
+        lock_guard<mutex> guard(wakeLock);  // 等后台线程进入wait后再通知，通知不会丢失
+    }
+    wake.notify_one();
+}
+
+/**
+ * 取一副洗好的牌
+ * @return 队列中的一副牌；队列为空时在调用线程现洗一副
+ */
+ShuffledDeck DeckPool::pop() {
+    ShuffledDeck deck;
+    if (tryPop(deck)) {
+        return deck;
+    }
+    fallbacks.fetch_add(1, memory_order_relaxed);
+    wakeRefiller();
+    return generate();
+}
+
+/**
+ * 后台补充循环 - 把队列填满后休眠，直到出队使队列降到一半以下或析构时被唤醒；休眠期间不轮询
+ */
+void DeckPool::refillLoop() {
+    while (!stopping.load(memory_order_relaxed)) {
+        ShuffledDeck deck = generate();
+        while (!ring.tryPush(deck)) {
+            unique_lock<mutex> guard(wakeLock);
+            if (stopping.load(memory_order_relaxed)) {
+                return;
+            }
+            refillerSleeping.store(true, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            wake.wait(guard, [this] {
+                return stopping.load(memory_order_relaxed) || ring.approximateSize() < lowWater;
+            });
+            refillerSleeping.store(false, memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+//
+// Created for pre-shuffled deck pool
+//
+
+#ifndef POKERSERVER_DECKPOOL_H
+#define POKERSERVER_DECKPOOL_H
+
+#include "Deck.h"
+#include "EntropyPool.h"
+#include "MpmcRing.h"
+#include "Rng.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+// 预洗牌池：每种牌桌（按随机数引擎区分）一个，后台线程不断洗好整副牌放进无锁环形队列
+// 开局时pop只是一次出队，不在游戏线程上运行CSPRNG；队列空时才退回到调用线程现洗
+// 每副牌由(池种子, 递增的牌局编号)确定，牌上附带种子，可用ShuffledDeck::fromSeed回放
+// CHACHA20池每副牌改用熵源的256位密钥洗（ShuffledDeck::fromKey），牌上附带密钥
+class DeckPool {
+public:
+    // capacity为队列容量（2的幂），队列低于一半时唤醒后台线程补充
+    // 池种子从系统熵源读取；CHACHA20池每副牌从熵源取新的密钥
+    explicit DeckPool(RngEngine engine = RngEngine::CHACHA20, size_t capacity = 256);
+    // 固定池种子，牌局编号从firstHand开始；CHACHA20的密钥由种子扩展，只用于模拟和测试
+    DeckPool(RngEngine engine, size_t capacity, uint64_t tableSeed, uint64_t firstHand = 0);
+    ~DeckPool();
+
+    DeckPool(const DeckPool&) = delete;
+    DeckPool& operator=(const DeckPool&) = delete;
+
+    // 取一副洗好的牌：可被多个游戏线程同时调用
+    ShuffledDeck pop();
+    bool tryPop(ShuffledDeck& deck);
+
+    RngEngine engine() const { return kind; }
+    uint64_t tableSeed() const { return seed; }
+    size_t available() const { return ring.approximateSize(); }
+    uint64_t fallbackCount() const { return fallbacks.load(memory_order_relaxed); } // 队列空时现洗的次数
+
+private:
+    RngEngine kind;
+    MpmcRing<ShuffledDeck> ring;
+    size_t lowWater;
+
+    thread refiller;
+    mutex wakeLock;
+    condition_variable wake;
+    atomic<bool> refillerSleeping;  // 后台线程正在（或即将）等待wake
+    atomic<bool> stopping;
+    atomic<uint64_t> fallbacks;
+
+    uint64_t seed;
+    atomic<uint64_t> nextHand;  // 下一副牌的牌局编号，后台线程和现洗共用
+    bool secureKeys;            // 每副牌是否从熵源取新的密钥（各线程各自的EntropyPool）
+
+    DeckPool(RngEngine engine, size_t capacity, uint64_t tableSeed, uint64_t firstHand, bool secureKeys);
+
+    ShuffledDeck generate() {
+        DealSeed handSeed{seed, nextHand.fetch_add(1)};
+        return secureKeys ? ShuffledDeck::fromKey(DealKey::fromEntropy(), handSeed)
+                          : ShuffledDeck::fromSeed(kind, handSeed);
+    }
+
+    void wakeRefiller(); // 出队之后调用
+    void refillLoop();
+};
+
+#endif //POKERSERVER_DECKPOOL_H
@@ -0,0 +1,139 @@
+//
+// Created for buffered kernel entropy
+// Linux上直接调用getrandom，其他平台退回random_device；两者都只在缓冲耗尽时调用
+//
+
+#include "EntropyPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/random.h>
+#else
+#include <random>
+#endif
+
+namespace {
+
+atomic<uint64_t> kernelCalls(0);
+atomic<uint64_t> kernelBytes(0);
+atomic<uint64_t> kernelNanoseconds(0);
+atomic<uint64_t> reseedTotal(0);
+atomic<uint64_t> globalReseedInterval(SecureRng::DEFAULT_RESEED_INTERVAL);
+
+/**
+ * 从系统熵源读满size字节
+ * @param out 输出缓冲
+ * @param size 字节数
+ */
+void readKernel(uint8_t* out, size_t size) {
+#ifdef __linux__
+    size_t done = 0;
+    while (done < size) {
+        ssize_t got = getrandom(out + done, size - done, 0);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw runtime_error("getrandom failed.");
+        }
+        done += static_cast<size_t>(got);
+    }
+#else
+    random_device device;
+    for (size_t i = 0; i < size; i += 4) {
+        uint32_t word = device();
+        memcpy(out + i, &word, size - i < 4 ? size - i : 4);
+    }
+#endif
+}
+
+} // namespace
+
+EntropyPool& EntropyPool::local() {
+    thread_local EntropyPool pool;
+    return pool;
+}
+
+void EntropyPool::refill() {
+    auto start = chrono::steady_clock::now();
+    readKernel(buffer, BLOCK_SIZE);
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    kernelCalls.fetch_add(1, memory_order_relaxed);
+    kernelBytes.fetch_add(BLOCK_SIZE, memory_order_relaxed);
+    kernelNanoseconds.fetch_add(static_cast<uint64_t>(elapsed), memory_order_relaxed);
+    position = 0;
+}
+
+/**
+ * 读取熵 - 缓冲中取过的字节立即清零，不在内存中留下已交付的熵
+ * @param out 输出缓冲
+ * @param size 字节数
+ */
+void EntropyPool::read(void* out, size_t size) {
+    uint8_t* bytes = static_cast<uint8_t*>(out);
+    while (size > 0) {
+        if (position == BLOCK_SIZE) {
+            refill();
+        }
+        size_t chunk = BLOCK_SIZE - position < size ? BLOCK_SIZE - position : size;
+        memcpy(bytes, buffer + position, chunk);
+        memset(buffer + position, 0, chunk);
+        position += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
+}
+
+uint64_t EntropyPool::next64() {
+    uint64_t value;
+    read(&value, sizeof(value));
+    return value;
+}
+
+EntropyStats EntropyPool::stats() {
+    EntropyStats result;
+    result.kernelCalls = kernelCalls.load(memory_order_relaxed);
+    result.kernelBytes = kernelBytes.load(memory_order_relaxed);
+    result.kernelSeconds = kernelNanoseconds.load(memory_order_relaxed) * 1e-9;
+    result.reseeds = reseedTotal.load(memory_order_relaxed);
+    return result;
+}
+
+SecureRng::SecureRng(uint64_t reseedInterval)
+    : interval(reseedInterval > 0 ? reseedInterval : DEFAULT_RESEED_INTERVAL),
+      remaining(0), reseeds(0), followGlobal(false) {
+}
+
+SecureRng& SecureRng::local() {
+    thread_local SecureRng rng = [] {
+        SecureRng instance;
+        instance.followGlobal = true;
+        return instance;
+    }();
+    return rng;
+}
+
+void SecureRng::setReseedInterval(uint64_t outputs) {
+    globalReseedInterval.store(outputs > 0 ? outputs : DEFAULT_RESEED_INTERVAL, memory_order_relaxed);
+}
+
+/**
+ * 重新播种 - 256位新密钥和64位流编号全部取自本线程的熵缓冲
+ */
+void SecureRng::reseed() {
+    array<uint32_t, 8> key;
+    EntropyPool& pool = EntropyPool::local();
+    pool.read(key.data(), sizeof(key));
+    stream = ChaCha20Rng(key, pool.next64());
+    memset(key.data(), 0, sizeof(key));
+    if (followGlobal) {
+        interval = globalReseedInterval.load(memory_order_relaxed);
+    }
+    remaining = interval;
+    ++reseeds;
+    reseedTotal.fetch_add(1, memory_order_relaxed);
+}
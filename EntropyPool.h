@@ -0,0 +1,82 @@
+//
+// Created for buffered kernel entropy
+//
+
+#ifndef POKERSERVER_ENTROPYPOOL_H
+#define POKERSERVER_ENTROPYPOOL_H
+
+#include "Rng.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+using namespace std;
+
+// 熵源统计（所有线程的合计），只在冷路径上更新
+struct EntropyStats {
+    uint64_t kernelCalls;    // 向系统熵源请求的次数
+    uint64_t kernelBytes;    // 从系统熵源读取的字节数
+    double kernelSeconds;    // 花在系统熵源上的时间
+    uint64_t reseeds;        // SecureRng重新播种的次数
+
+    double bytesPerSecond() const { return kernelSeconds > 0.0 ? kernelBytes / kernelSeconds : 0.0; }
+};
+
+// 每线程的熵缓冲：一次从getrandom读取一大块，之后按需切分，摊薄系统调用
+class EntropyPool {
+public:
+    static const size_t BLOCK_SIZE = 4096;
+
+    static EntropyPool& local(); // 当前线程的缓冲
+
+    void read(void* out, size_t size);
+    uint64_t next64();
+
+    static EntropyStats stats();
+
+private:
+    uint8_t buffer[BLOCK_SIZE];
+    size_t position;
+
+    EntropyPool() : position(BLOCK_SIZE) {}
+    void refill();
+};
+
+// 按计划重新播种的ChaCha20：密钥取自EntropyPool，输出一定数量后换新密钥
+// 真钱牌桌用它产生每局的种子，热路径上只是ChaCha20运算
+class SecureRng {
+public:
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<uint64_t>::max(); }
+
+    static const uint64_t DEFAULT_RESEED_INTERVAL = 1 << 16;
+
+    explicit SecureRng(uint64_t reseedInterval = DEFAULT_RESEED_INTERVAL);
+
+    static SecureRng& local(); // 当前线程的实例，按全局设置的间隔重新播种
+
+    // 设置此后各线程local()实例的重新播种间隔（64位输出的个数），0表示使用默认值
+    static void setReseedInterval(uint64_t outputs);
+
+    result_type operator()() {
+        if (remaining == 0) {
+            reseed();
+        }
+        --remaining;
+        return stream();
+    }
+
+    uint64_t reseedCount() const { return reseeds; }
+
+private:
+    ChaCha20Rng stream;
+    uint64_t interval;
+    uint64_t remaining;  // 距离下次重新播种还能输出的个数
+    uint64_t reseeds;
+    bool followGlobal;   // 是否跟随setReseedInterval
+
+    void reseed();
+};
+
+#endif //POKERSERVER_ENTROPYPOOL_H
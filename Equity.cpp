@@ -0,0 +1,315 @@
+//
+// Created for equity calculation
+// 未知对手之间可交换，只枚举组合下标递增的对手手牌组合，结果与按顺序枚举相同
+//
+
+#include "Equity.h"
+#include "HandStrength.h"
+#include "ThreadPool.h"
+#include "Rng.h"
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// 精确枚举允许的最大发牌方案数
+const double MAX_EXACT_DEALS = 4e9;
+
+// 每线程的累加器，按缓存行对齐，线程之间不共享缓存行
+struct alignas(CACHE_LINE_SIZE) EquityAccumulator {
+    uint64_t wins[MAX_EQUITY_PLAYERS];
+    uint64_t ties[MAX_EQUITY_PLAYERS];
+    double shares[MAX_EQUITY_PLAYERS];
+    double shareSquares[MAX_EQUITY_PLAYERS];  // 份额平方和，用于估计方差
+    uint64_t deals;
+};
+
+// 未知对手可用的一手牌
+struct OpenHand {
+    uint64_t mask;
+    int strength;
+};
+
+// 一次枚举任务的共享只读数据
+struct EnumerationContext {
+    int knownCount;
+    int unknownCount;
+    int strengths[MAX_EQUITY_PLAYERS];  // 已知玩家在前，未知对手在后
+    vector<OpenHand> openHands;         // 与已知手牌不冲突的全部手牌，按组合下标递增
+};
+
+// 结算一次发牌：找出最大的等效牌力及并列人数，给已知玩家记账
+void settleDeal(const int* strengths, int seats, int knownCount, EquityAccumulator& acc) {
+    bool hasLeopard = false;
+    for (int i = 0; i < seats; ++i) {
+        hasLeopard |= isLeopardStrength(strengths[i]);
+    }
+
+    int best = -1;
+    int winners = 0;
+    for (int i = 0; i < seats; ++i) {
+        int value = strengths[i];
+        if (hasLeopard && isSpecial235Strength(value)) {
+            value = 1 << 16;  // 235反杀豹子，与rankShowdown的处理一致
+        }
+        if (value > best) {
+            best = value;
+            winners = 1;
+        } else if (value == best) {
+            ++winners;
+        }
+    }
+
+    for (int i = 0; i < knownCount; ++i) {
+        int value = strengths[i];
+        if (hasLeopard && isSpecial235Strength(value)) {
+            value = 1 << 16;
+        }
+        if (value == best) {
+            if (winners == 1) {
+                ++acc.wins[i];
+            } else {
+                ++acc.ties[i];
+            }
+            double share = 1.0 / winners;
+            acc.shares[i] += share;
+            acc.shareSquares[i] += share * share;
+        }
+    }
+    ++acc.deals;
+}
+
+// 递归枚举第depth名未知对手的手牌，只取下标大于first的手牌以去掉对手之间的排列
+void enumerate(const EnumerationContext& ctx, int depth, size_t first, uint64_t usedMask,
+               int* strengths, EquityAccumulator& acc) {
+    int seat = ctx.knownCount + depth;
+    if (depth == ctx.unknownCount) {
+        settleDeal(strengths, seat, ctx.knownCount, acc);
+        return;
+    }
+    for (size_t i = first; i < ctx.openHands.size(); ++i) {
+        const OpenHand& hand = ctx.openHands[i];
+        if (hand.mask & usedMask) {
+            continue;
+        }
+        strengths[seat] = hand.strength;
+        enumerate(ctx, depth + 1, i + 1, usedMask | hand.mask, strengths, acc);
+    }
+}
+
+/**
+ * 校验已知手牌并查出牌力
+ * @return 已知手牌占用的牌的掩码
+ */
+uint64_t prepareKnownHands(const vector<Hand>& knownHands, int unknownOpponents, int* strengths) {
+    int knownCount = static_cast<int>(knownHands.size());
+    if (knownCount <= 0 || unknownOpponents < 0 || knownCount + unknownOpponents > MAX_EQUITY_PLAYERS) {
+        throw invalid_argument("Invalid player count for equity calculation.");
+    }
+    if (knownCount + unknownOpponents < 2) {
+        throw invalid_argument("Equity needs at least two players.");
+    }
+
+    uint64_t deadMask = 0;
+    for (int i = 0; i < knownCount; ++i) {
+        const Hand& hand = knownHands[i];
+        uint64_t mask = handMask(hand);
+        if ((mask & deadMask) || hand[0] == hand[1] || hand[1] == hand[2] || hand[0] == hand[2]) {
+            throw invalid_argument("Known hands must not share cards.");
+        }
+        deadMask |= mask;
+        strengths[i] = handStrength(hand);
+    }
+    return deadMask;
+}
+
+double choose(int n, int k) {
+    double result = 1.0;
+    for (int i = 0; i < k; ++i) {
+        result = result * (n - i) / (i + 1);
+    }
+    return result;
+}
+
+} // namespace
+
+/**
+ * 精确胜率计算
+ * 第一名未知对手的每一手牌作为一个任务分给线程池，各线程写自己的累加器，最后汇总
+ * @param knownHands 已知的手牌，彼此不能有重复的牌
+ * @param unknownOpponents 未知对手数
+ * @param threadCount 线程数，0表示使用硬件线程数
+ * @return 每名已知玩家的胜率以及枚举的方案数
+ */
+EquityReport calculateEquityExact(const vector<Hand>& knownHands, int unknownOpponents, int threadCount) {
+    int knownCount = static_cast<int>(knownHands.size());
+    EnumerationContext ctx;
+    ctx.knownCount = knownCount;
+    ctx.unknownCount = unknownOpponents;
+    uint64_t deadMask = prepareKnownHands(knownHands, unknownOpponents, ctx.strengths);
+
+    int remaining = 52 - 3 * knownCount;
+    double deals = 1.0;
+    for (int k = 0; k < unknownOpponents; ++k) {
+        deals *= choose(remaining - 3 * k, 3);
+    }
+    for (int k = 2; k <= unknownOpponents; ++k) {
+        deals /= k;  // 未知对手之间不计顺序
+    }
+    if (deals > MAX_EXACT_DEALS) {
+        throw invalid_argument("Too many deals for exact equity (" + to_string(static_cast<long long>(deals)) +
+                               "), use the Monte Carlo estimator instead.");
+    }
+
+    for (int index = 0; index < HAND_COUNT; ++index) {
+        uint64_t mask = handMask(handFromIndex(index));
+        if ((mask & deadMask) == 0) {
+            ctx.openHands.push_back(OpenHand{mask, handStrength(index)});
+        }
+    }
+
+    ThreadPool pool(threadCount);
+    vector<EquityAccumulator> accumulators(pool.size());
+    for (auto& acc : accumulators) {
+        acc = EquityAccumulator{};
+    }
+
+    if (unknownOpponents == 0) {
+        settleDeal(ctx.strengths, knownCount, knownCount, accumulators[0]);
+    } else {
+        pool.parallelFor(static_cast<int>(ctx.openHands.size()), [&](int task, int worker) {
+            int strengths[MAX_EQUITY_PLAYERS];
+            for (int i = 0; i < knownCount; ++i) {
+                strengths[i] = ctx.strengths[i];
+            }
+            const OpenHand& first = ctx.openHands[task];
+            strengths[knownCount] = first.strength;
+            enumerate(ctx, 1, task + 1, first.mask, strengths, accumulators[worker]);
+        });
+    }
+
+    // 汇总各线程的累加器
+    EquityReport report;
+    report.deals = 0;
+    report.players.assign(knownCount, EquityResult{0.0, 0.0, 0.0});
+    uint64_t wins[MAX_EQUITY_PLAYERS] = {};
+    uint64_t ties[MAX_EQUITY_PLAYERS] = {};
+    double shares[MAX_EQUITY_PLAYERS] = {};
+    for (const auto& acc : accumulators) {
+        report.deals += acc.deals;
+        for (int i = 0; i < knownCount; ++i) {
+            wins[i] += acc.wins[i];
+            ties[i] += acc.ties[i];
+            shares[i] += acc.shares[i];
+        }
+    }
+    for (int i = 0; i < knownCount; ++i) {
+        report.players[i].win = static_cast<double>(wins[i]) / report.deals;
+        report.players[i].tie = static_cast<double>(ties[i]) / report.deals;
+        report.players[i].equity = shares[i] / report.deals;
+    }
+    return report;
+}
+
+/**
+ * 蒙特卡洛胜率估计
+ * 抽样总数按流数均分，第t段固定使用第t条随机流，因此结果只取决于种子和流数，与线程调度无关
+ * 每次抽样用部分Fisher-Yates从剩余牌中只抽出未知对手需要的3×N张
+ * @param knownHands 已知的手牌，彼此不能有重复的牌
+ * @param unknownOpponents 未知对手数
+ * @param options 抽样次数、种子、线程数和置信水平
+ * @return 每名已知玩家的估计值、置信半宽以及抽样速度
+ */
+MonteCarloReport calculateEquityMonteCarlo(const vector<Hand>& knownHands, int unknownOpponents,
+                                           const MonteCarloOptions& options) {
+    int knownCount = static_cast<int>(knownHands.size());
+    int strengths[MAX_EQUITY_PLAYERS];
+    uint64_t deadMask = prepareKnownHands(knownHands, unknownOpponents, strengths);
+    if (options.samples == 0) {
+        throw invalid_argument("Monte Carlo needs at least one sample.");
+    }
+
+    // 剩余的牌
+    uint8_t liveCards[52];
+    int liveCount = 0;
+    for (int card = 0; card < 52; ++card) {
+        if ((deadMask >> card & 1) == 0) {
+            liveCards[liveCount++] = static_cast<uint8_t>(card);
+        }
+    }
+
+    ThreadPool pool(options.threadCount);
+    int streams = pool.size();
+    vector<EquityAccumulator> accumulators(streams);
+    for (auto& acc : accumulators) {
+        acc = EquityAccumulator{};
+    }
+
+    auto start = chrono::steady_clock::now();
+    pool.parallelFor(streams, [&](int stream, int) {
+        EquityAccumulator& acc = accumulators[stream];
+        CounterRng rng(options.seed, static_cast<uint64_t>(stream));
+        uint64_t begin = options.samples * stream / streams;
+        uint64_t end = options.samples * (stream + 1) / streams;
+
+        uint8_t cards[52];
+        for (int i = 0; i < liveCount; ++i) {
+            cards[i] = liveCards[i];
+        }
+        int seatStrengths[MAX_EQUITY_PLAYERS];
+        for (int i = 0; i < knownCount; ++i) {
+            seatStrengths[i] = strengths[i];
+        }
+
+        for (uint64_t sample = begin; sample < end; ++sample) {
+            // 部分Fisher-Yates：只洗出前3×N张，剩余顺序无关紧要，不必复原
+            for (int i = 0; i < 3 * unknownOpponents; ++i) {
+                int j = i + static_cast<int>(uniformBelow(rng, static_cast<uint32_t>(liveCount - i)));
+                uint8_t t = cards[i]; cards[i] = cards[j]; cards[j] = t;
+            }
+            for (int k = 0; k < unknownOpponents; ++k) {
+                Hand hand = {Card::fromIndex(cards[3 * k]), Card::fromIndex(cards[3 * k + 1]),
+                             Card::fromIndex(cards[3 * k + 2])};
+                seatStrengths[knownCount + k] = handStrength(hand);
+            }
+            settleDeal(seatStrengths, knownCount + unknownOpponents, knownCount, acc);
+        }
+    });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // 按流的编号顺序汇总，保证浮点累加顺序固定
+    MonteCarloReport report;
+    report.samples = 0;
+    report.threadCount = streams;
+    report.seconds = seconds;
+    uint64_t wins[MAX_EQUITY_PLAYERS] = {};
+    uint64_t ties[MAX_EQUITY_PLAYERS] = {};
+    double shares[MAX_EQUITY_PLAYERS] = {};
+    double shareSquares[MAX_EQUITY_PLAYERS] = {};
+    for (const auto& acc : accumulators) {
+        report.samples += acc.deals;
+        for (int i = 0; i < knownCount; ++i) {
+            wins[i] += acc.wins[i];
+            ties[i] += acc.ties[i];
+            shares[i] += acc.shares[i];
+            shareSquares[i] += acc.shareSquares[i];
+        }
+    }
+    report.samplesPerSecond = seconds > 0.0 ? report.samples / seconds : 0.0;
+
+    double n = static_cast<double>(report.samples);
+    for (int i = 0; i < knownCount; ++i) {
+        EquityEstimate estimate;
+        estimate.value.win = wins[i] / n;
+        estimate.value.tie = ties[i] / n;
+        estimate.value.equity = shares[i] / n;
+        double winVariance = estimate.value.win * (1.0 - estimate.value.win);
+        double equityVariance = shareSquares[i] / n - estimate.value.equity * estimate.value.equity;
+        estimate.winMargin = options.z * sqrt(winVariance / n);
+        estimate.equityMargin = options.z * sqrt(max(equityVariance, 0.0) / n);
+        report.players.push_back(estimate);
+    }
+    return report;
+}
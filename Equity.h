@@ -0,0 +1,65 @@
+//
+// Created for equity calculation
+//
+
+#ifndef POKERSERVER_EQUITY_H
+#define POKERSERVER_EQUITY_H
+
+#include "Card.h"
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// 一张牌桌最多的玩家数：52 / 3
+const int MAX_EQUITY_PLAYERS = 17;
+
+// 单个已知手牌玩家的胜率
+struct EquityResult {
+    double win;     // 独赢概率
+    double tie;     // 与他人并列最大的概率
+    double equity;  // 期望份额：独赢计1，与k人并列计1/k
+};
+
+// 精确胜率计算的汇总
+struct EquityReport {
+    vector<EquityResult> players;  // 与输入的已知手牌一一对应
+    uint64_t deals;                // 枚举的发牌方案数（未知对手之间不计顺序）
+};
+
+// 精确胜率：已知若干玩家的手牌，另有unknownOpponents名未知对手从剩余牌中发牌，
+// 枚举全部发牌方案后给出每名已知玩家的胜率；比牌规则与compareHands一致（含235反杀豹子和花色比较）
+// 枚举量超过上限时抛出invalid_argument，此时应改用蒙特卡洛估计
+// threadCount为0时使用硬件线程数
+EquityReport calculateEquityExact(const vector<Hand>& knownHands, int unknownOpponents, int threadCount = 0);
+
+// 蒙特卡洛估计的参数
+struct MonteCarloOptions {
+    uint64_t samples = 1000000;  // 抽样次数
+    uint64_t seed = 0;           // 随机种子
+    int threadCount = 0;         // 线程数（即随机流数），0表示使用硬件线程数
+    double z = 1.96;             // 置信区间的正态分位数，默认95%
+};
+
+// 单个已知手牌玩家的估计值及置信区间
+struct EquityEstimate {
+    EquityResult value;
+    double winMargin;     // 独赢概率的置信半宽
+    double equityMargin;  // 期望份额的置信半宽
+};
+
+// 蒙特卡洛估计的汇总
+struct MonteCarloReport {
+    vector<EquityEstimate> players;
+    uint64_t samples;
+    int threadCount;          // 实际使用的随机流数
+    double seconds;
+    double samplesPerSecond;
+};
+
+// 蒙特卡洛胜率估计：适合人数较多、无法精确枚举的情况
+// 第t个线程使用以(种子, t)为键的计数器随机流，相同种子和线程数下结果逐位可复现
+MonteCarloReport calculateEquityMonteCarlo(const vector<Hand>& knownHands, int unknownOpponents,
+                                           const MonteCarloOptions& options = MonteCarloOptions());
+
+#endif //POKERSERVER_EQUITY_H
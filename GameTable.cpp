@@ -0,0 +1,53 @@
+//
+// Created for GoldenFlower table engine
+//
+
+#include "GameTable.h"
+#include <stdexcept>
+
+namespace {
+
+// 固定种子时选庄的随机流，与发牌使用的牌局编号错开
+const uint64_t DEALER_STREAM = ~0ULL;
+
+} // namespace
+
+template <int Seats>
+BasicGameTable<Seats>::BasicGameTable(RngEngine engine)
+    : table(), dealing(engine), dealerRng(RngEngine::XOSHIRO256) {
+}
+
+template <int Seats>
+BasicGameTable<Seats>::BasicGameTable(RngEngine engine, uint64_t tableSeed)
+    : table(), dealing(engine, tableSeed), dealerRng(RngEngine::XOSHIRO256, tableSeed, DEALER_STREAM) {
+}
+
+template <int Seats>
+void BasicGameTable<Seats>::seatPlayers(int count, int initialMoney) {
+    table.seatPlayers(count, initialMoney);
+    names.clear();
+    for (int i = 0; i < count; ++i) {
+        names.push_back("玩家" + to_string(i + 1));
+    }
+}
+
+/**
+ * 开始一局 - 先检查入场费再发牌，不合法时不消耗牌局编号
+ * @param entranceFee 本局入场费
+ */
+template <int Seats>
+void BasicGameTable<Seats>::startHand(int entranceFee) {
+    table.checkStart(entranceFee);
+    dealing.resetDeck(); // 每局收回所有牌，发牌时才洗
+    array<Hand, Seats> hands;
+    // 一副牌最多发MAX_DEAL_HANDS手，更多座位需要先useShoe；发不出时牌桌保持不变
+    if (dealing.dealCards(table.seatCount, hands.data(), Seats) != DealStatus::OK) {
+        throw invalid_argument("Not enough cards for " + to_string(table.seatCount) +
+                               " players; use a shoe with more decks.");
+    }
+    int dealer = static_cast<int>(uniformBelow(dealerRng, static_cast<uint32_t>(table.seatCount)));
+    table.startHand(entranceFee, hands.data(), dealer, dealing.deckCount() > 1);
+}
+
+template class BasicGameTable<MAX_TABLE_SEATS>;
+template class BasicGameTable<MAX_SHOE_SEATS>;
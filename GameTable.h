@@ -0,0 +1,63 @@
+//
+// Created for GoldenFlower table engine
+// 炸金花牌桌：TableState加上发牌、选庄和玩家名称，界面和服务器通过它推进牌局
+//
+
+#ifndef POKERSERVER_GAMETABLE_H
+#define POKERSERVER_GAMETABLE_H
+
+#include <string>
+#include <vector>
+#include "PokerGame.h"
+#include "TableState.h"
+
+using namespace std;
+
+// 牌桌：规则和数值都在BasicTableState里，这里负责洗牌发牌、随机选庄和显示用的名称
+// Seats与BasicTableState相同：GameTable为一副牌的牌桌，ShoeGameTable为牌靴牌桌
+template <int Seats>
+class BasicGameTable {
+public:
+    using State = BasicTableState<Seats>;
+
+    // 选庄和发牌的随机数都从系统熵源播种
+    explicit BasicGameTable(RngEngine engine = RngEngine::CHACHA20);
+    // 固定牌桌种子：选庄和每局发牌都可复现，用于模拟和回放
+    BasicGameTable(RngEngine engine, uint64_t tableSeed);
+
+    // 入座count名玩家（最多Seats人），每人initialMoney；人数或金额不合法时抛出invalid_argument
+    // 超过一副牌能发的手数（MAX_DEAL_HANDS）时需要useShoe
+    void seatPlayers(int count, int initialMoney);
+    // 发牌来源，见GameLogic::useDeckPool/useShoe
+    void useDeckPool(DeckPool* deckPool) { dealing.useDeckPool(deckPool); }
+    void useShoe(int decks) { dealing.useShoe(decks); }
+
+    // 开始一局：收取入场费、随机选庄、发牌，庄家先说话
+    // 入场费不在[1, maxEntranceFee()]内、上一局未结束或发牌来源的牌不够时抛出invalid_argument
+    void startHand(int entranceFee);
+
+    // 当前玩家的操作，见BasicTableState
+    ActionStatus look() { return table.look(); }
+    ActionStatus bet(int amount) { return table.bet(amount); }
+    ActionStatus fold() { return table.fold(); }
+    ActionStatus showdown(int target, ShowdownOutcome& outcome) { return table.showdown(target, outcome); }
+
+    const State& state() const { return table; }
+    const string& name(int seat) const { return names[seat]; }
+    DealSeed handSeed() const { return dealing.lastDealSeed(); } // 本局牌的种子，可用GameLogic::replayDeal回放
+    DealKey handKey() const { return dealing.lastDealKey(); }    // CHACHA20牌桌本局的密钥，回放时与种子一起使用
+
+private:
+    State table;
+    vector<string> names; // 玩家名称，只用于显示
+    GameLogic dealing;    // 洗牌发牌
+    TableRng dealerRng;   // 选庄用的随机数生成器
+};
+
+using GameTable = BasicGameTable<MAX_TABLE_SEATS>;
+using ShoeGameTable = BasicGameTable<MAX_SHOE_SEATS>;
+
+extern template class BasicGameTable<MAX_TABLE_SEATS>;
+extern template class BasicGameTable<MAX_SHOE_SEATS>;
+
+#endif //POKERSERVER_GAMETABLE_H
@@ -8,57 +8,12 @@
 #include "GoldenFlower.h"  // 包含游戏头文件，定义了游戏的类和枚举
 #include "Card.h"          // 包含扑克牌类定义，用于牌面显示和牌型判断
 #include <QEvent>          // 包含Qt事件类，用于处理窗口大小变化等事件
-#include <algorithm>       // 包含算法库，用于洗牌(random_shuffle)和排序(sort)
+#include <algorithm>       // 包含算法库，用于排序(sort)
 #include <cmath>           // 包含数学库，用于计算玩家位置的三角函数和平方根
 #include <QPixmap>         // 包含Qt图像处理类，用于加载和显示扑克牌图片
 #include <QDir>            // 包含Qt目录操作类，用于查找和访问扑克牌图片文件
 #include <QGroupBox>       // 包含Qt分组框类，用于创建玩家信息和卡牌的分组显示
 
-// Player类实现 - 玩家类负责管理玩家的状态、资金和手牌
-
-/**
- * 玩家类构造函数 - 初始化玩家的基本属性
- * @param name 玩家名称，用于界面显示和标识
- * @param initialMoney 玩家初始金额，决定玩家可下注的资金上限
- */
-Player::Player(const string& name, int initialMoney) 
-    : name(name),                    // 初始化玩家名称
-      money(initialMoney),           // 初始化玩家初始金额
-      currentBet(0),                 // 初始化当前总下注金额为0
-      currentRoundBet(0),            // 初始化当前轮次下注金额为0（用于计算跟注金额）
-      status(PlayerStatus::BLIND),   // 初始化玩家状态为蒙牌（未看牌）
-      isDealer(false) {}             // 初始化玩家不是庄家（每局随机选择庄家）
-
-/**
- * 重置玩家状态 - 在开始新一局游戏时调用，清空上一局的状态
- * 包括清空手牌、重置下注金额和玩家状态
- */
-void Player::reset() {
-    cards.clear();                   // 清空玩家手牌，准备接收新牌
-    currentBet = 0;                  // 重置当前总下注额为0
-    currentRoundBet = 0;             // 重置当前轮次下注额为0
-    status = PlayerStatus::BLIND;    // 重置玩家状态为蒙牌（未看牌）
-}
-
-/**
- * 玩家下注方法 - 处理玩家下注逻辑
- * @param amount 下注金额，如果超过玩家剩余资金则按最大资金下注
- */
-void Player::placeBet(int amount) {
-    if (amount > money) amount = money; // 防止超额下注，最多下注玩家所有剩余金额
-    money -= amount;                   // 从玩家余额中扣除下注金额
-    currentBet += amount;              // 增加玩家当前总下注额（累计所有轮次）
-    currentRoundBet = amount;          // 记录当前轮次下注金额（仅当前轮次）
-}
-
-/**
- * 玩家接收一张牌 - 在发牌阶段调用
- * @param card 牌的字符串表示，例如 "A of Hearts"
- */
-void Player::receiveCard(const string& card) {
-    cards.push_back(card);             // 将牌添加到玩家手牌中
-}
-
 // GoldenFlowerWindow类实现 - 游戏主窗口类，负责界面显示和游戏逻辑控制
 
 /**
@@ -67,17 +22,16 @@ void Player::receiveCard(const string& card) {
  */
 GoldenFlowerWindow::GoldenFlowerWindow(QWidget *parent)
     : QMainWindow(parent),            // 调用父类QMainWindow构造函数
-      currentPlayerIndex(0),          // 初始化当前操作玩家的索引为0
-      pot(0),                         // 初始化奖池金额为0（不包括入场费）
-      minBet(10),                     // 初始化最小下注额为10（可在游戏开始时修改）
-      entranceFee(10),                // 初始化入场费为10（每局游戏开始时收取）
-      gameInProgress(false),          // 初始化游戏状态为未进行中
+      minBet(10),                     // 初始化最小下注额为10（第一局入场费的默认值）
       tableWidth(550),                // 初始化牌桌宽度为550像素
       tableHeight(350),               // 初始化牌桌高度为350像素
       playerInfoDistance(50),         // 初始化玩家信息距离牌桌边缘的距离为50像素
       cardDistance(50),               // 初始化卡牌距离牌桌中心的距离为50像素
       scaleFactor(1.0),               // 初始化界面缩放因子为1.0（原始大小）
-      maxPlayers(4) {                 // 初始化最大玩家数为4
+      maxPlayers(4),                  // 初始化最大玩家数为4
+      deckPool(RngEngine::CHACHA20, 16), // 预洗牌池：一张牌桌每局只取一副，容量不必大
+      table(RngEngine::CHACHA20) {     // 牌桌规则，选庄的随机数只在创建窗口时从系统熵源播种一次
+    table.useDeckPool(&deckPool);     // 开局时直接从预洗牌池取一副洗好的牌
     initializeUI();                   // 调用初始化用户界面方法，创建并设置UI组件
     
     // 安装事件过滤器，用于捕获窗口大小变化事件和卡牌悬停事件
@@ -151,8 +105,9 @@ bool GoldenFlowerWindow::eventFilter(QObject *watched, QEvent *event) {
         int playerIndex = cardLabel->objectName().split("_")[1].toInt();
         int cardIndex = cardLabel->objectName().split("_")[2].toInt();
         
-        if (playerIndex < players.size() && 
-            (players[playerIndex].status == PlayerStatus::LOOKED || !gameInProgress)) {
+        const TableState& state = table.state();
+        if (playerIndex < state.seatCount && 
+            (state.status[playerIndex] == PlayerStatus::LOOKED || !state.playing)) {
             
             if (event->type() == QEvent::Enter) {
                 // 鼠标进入卡牌区域 - 放大卡牌
@@ -329,7 +284,7 @@ void GoldenFlowerWindow::setDistanceParameters(int newPlayerInfoDistance, int ne
     cardDistance = newCardDistance;             // 更新卡牌距离
     
     // 如果游戏正在进行中，立即更新UI以反映新的布局参数
-    if (gameInProgress) {
+    if (table.state().playing) {
         updateUI();  // 调用UI更新方法
     }
 }
@@ -421,7 +376,7 @@ void GoldenFlowerWindow::adjustLayoutParameters(int newTableWidth, int newTableH
     }
     
     // 如果游戏正在进行中，更新UI以反映新的布局参数
-    if (gameInProgress) {
+    if (table.state().playing) {
         updateUI();  // 调用UI更新方法，重新布局所有游戏元素
     }
 }
@@ -430,11 +385,13 @@ void GoldenFlowerWindow::adjustLayoutParameters(int newTableWidth, int newTableH
  * 显示比牌结果对话框 - 用于处理两名玩家之间的比牌结果显示
  * @param player1Index 第一个玩家的索引
  * @param player2Index 第二个玩家的索引
+ * @param winnerIndex 获胜玩家的索引，比牌已由牌桌完成
  * 对话框显示两名玩家的牌面，并标记获胜者
  */
-void GoldenFlowerWindow::showComparisonDialog(int player1Index, int player2Index) {
-    Player& player1 = players[player1Index];  // 获取第一个玩家的引用
-    Player& player2 = players[player2Index];  // 获取第二个玩家的引用
+void GoldenFlowerWindow::showComparisonDialog(int player1Index, int player2Index, int winnerIndex) {
+    const TableState& state = table.state();
+    const string& player1Name = table.name(player1Index);  // 第一个玩家的名称
+    const string& player2Name = table.name(player2Index);  // 第二个玩家的名称
     
     // 创建模态对话框来显示比牌结果
     QDialog resultDialog(this);               // 创建对话框，设置父窗口为当前窗口
@@ -450,7 +407,7 @@ void GoldenFlowerWindow::showComparisonDialog(int player1Index, int player2Index
     mainLayout->addWidget(titleLabel);           // 将标题标签添加到主布局
     
     // 显示第一个玩家的牌面区域
-    QGroupBox* player1Box = new QGroupBox(QString::fromStdString(player1.name));  // 创建分组框，标题为玩家名称
+    QGroupBox* player1Box = new QGroupBox(QString::fromStdString(player1Name));  // 创建分组框，标题为玩家名称
     QVBoxLayout* player1Layout = new QVBoxLayout(player1Box);  // 创建垂直布局用于组织玩家区域内的元素
     
     // 创建水平布局用于显示第一个玩家的卡牌
@@ -458,8 +415,7 @@ void GoldenFlowerWindow::showComparisonDialog(int player1Index, int player2Index
     player1CardLayout->setAlignment(Qt::AlignCenter);    // 设置卡牌在布局中居中对齐
     player1CardLayout->setSpacing(10);                   // 设置卡牌之间的间距为10像素
     
-    for (const auto& cardStr : player1.cards) {    // 遍历第一个玩家的每张牌
-        Card card(cardStr);                             // 从字符串创建Card对象
+    for (const Card& card : state.hands[player1Index]) {       // 遍历第一个玩家的每张牌
         QLabel* cardLabel = new QLabel();               // 创建标签用于显示卡牌
         cardLabel->setFixedSize(80, 120);               // 设置卡牌大小
         
@@ -486,15 +442,14 @@ void GoldenFlowerWindow::showComparisonDialog(int player1Index, int player2Index
     mainLayout->addWidget(player1Box);             // 将第一个玩家分组框添加到主布局
     
     // 显示第二个玩家的牌
-    QGroupBox* player2Box = new QGroupBox(QString::fromStdString(player2.name));  // 创建第二个玩家分组框
+    QGroupBox* player2Box = new QGroupBox(QString::fromStdString(player2Name));  // 创建第二个玩家分组框
     QVBoxLayout* player2Layout = new QVBoxLayout(player2Box);  // 创建垂直布局用于第二个玩家区域
     
     QHBoxLayout* player2CardLayout = new QHBoxLayout();  // 创建水平布局用于显示第二个玩家的卡牌
     player2CardLayout->setAlignment(Qt::AlignCenter);    // 设置卡牌居中对齐
     player2CardLayout->setSpacing(10);                   // 设置卡牌间距
     
-    for (const auto& cardStr : player2.cards) {  // 遍历第二个玩家的每张牌
-        Card card(cardStr);                             // 从字符串创建Card对象
+    for (const Card& card : state.hands[player2Index]) {     // 遍历第二个玩家的每张牌
         QLabel* cardLabel = new QLabel();               // 创建标签用于显示卡牌
         cardLabel->setFixedSize(80, 120);               // 设置卡牌大小
         
@@ -520,8 +475,7 @@ void GoldenFlowerWindow::showComparisonDialog(int player1Index, int player2Index
     player2Layout->addLayout(player2CardLayout);     // 将卡牌布局添加到第二个玩家布局
     mainLayout->addWidget(player2Box);              // 将第二个玩家分组框添加到主布局
     
-    // 比较牌型并确定胜者
-    bool player1Wins = compareHands(player1.cards, player2.cards);  // 比较两手牌的大小
+    bool player1Wins = winnerIndex == player1Index;  // 第一个玩家是否获胜
     
     // 添加获胜者信息
     QLabel* winnerLabel = new QLabel();                // 创建获胜者信息标签
@@ -529,14 +483,14 @@ void GoldenFlowerWindow::showComparisonDialog(int player1Index, int player2Index
     winnerLabel->setStyleSheet("font-size: 16px; font-weight: bold; color: gold; margin: 10px 0;");  // 设置标签样式
     
     if (player1Wins) {  // 如果第一个玩家获胜
-        winnerLabel->setText(QString::fromStdString("获胜者: " + player1.name));  // 设置获胜者文本
+        winnerLabel->setText(QString::fromStdString("获胜者: " + player1Name));  // 设置获胜者文本
         // 在第一个玩家的卡牌区域添加获胜标记
         QLabel* winMark = new QLabel("获胜");          // 创建获胜标记标签
         winMark->setAlignment(Qt::AlignCenter);        // 设置标签居中对齐
         winMark->setStyleSheet("color: gold; font-weight: bold;");  // 设置金色加粗文本
         player1Layout->addWidget(winMark);       // 将获胜标记添加到第一个玩家布局
     } else {  // 如果第二个玩家获胜
-        winnerLabel->setText(QString::fromStdString("获胜者: " + player2.name));  // 设置获胜者文本
+        winnerLabel->setText(QString::fromStdString("获胜者: " + player2Name));  // 设置获胜者文本
         // 在第二个玩家的卡牌区域添加获胜标记
         QLabel* winMark = new QLabel("获胜");          // 创建获胜标记标签
         winMark->setAlignment(Qt::AlignCenter);        // 设置标签居中对齐
@@ -553,71 +507,6 @@ void GoldenFlowerWindow::showComparisonDialog(int player1Index, int player2Index
     connect(okButton, &QPushButton::clicked, &resultDialog, &QDialog::accept);
     mainLayout->addWidget(okButton, 0, Qt::AlignCenter);  // 将按钮添加到主布局并居中
     
-    // 计算当前活跃玩家数量（未弃牌的玩家）
-    int activePlayers = 0;                                // 初始化活跃玩家计数器为0
-    for (const auto& player : players) {                  // 遍历所有玩家
-        if (player.status != PlayerStatus::FOLDED) {      // 如果玩家未弃牌
-            activePlayers++;                              // 活跃玩家数量加1
-        }
-    }
-    
-    // 处理比牌结果
-    if (player1Wins) {
-        // 第一个玩家获胜
-        // 将第二个玩家的下注金额加到第一个玩家的下注金额上，而不是余额上
-        player1.currentBet += player2.currentBet;
-        player2.status = PlayerStatus::FOLDED;
-        
-        // 如果比牌前只剩两名玩家，则第一个玩家获得所有奖池并结束游戏
-        if (activePlayers == 2) {
-            // 将赢家的下注金额加到余额上
-            player1.money += player1.currentBet;
-            // 将奖池中的入场费加到赢家余额上
-            player1.money += pot;
-            pot = 0;
-            
-            // 游戏结束
-            gameInProgress = false;
-            startButton->setText(players.empty() ? "开始游戏" : "继续游戏");  // 根据是否有玩家设置按钮文本
-            startButton->setEnabled(true);                   // 启用开始游戏按钮
-            lookButton->setEnabled(false);                   // 禁用看牌按钮
-            betButton->setEnabled(false);                    // 禁用下注按钮
-            foldButton->setEnabled(false);                   // 禁用弃牌按钮
-            requestShowdownButton->setEnabled(false);        // 禁用请求开牌按钮
-            
-            // 显示游戏结束消息
-            QMessageBox::information(this, "游戏结束",
-                                   QString::fromStdString(player1.name + " 获胜!"));
-        }
-    } else {
-        // 第二个玩家获胜
-        // 将第一个玩家的下注金额加到第二个玩家的下注金额上，而不是余额上
-        player2.currentBet += player1.currentBet;
-        player1.status = PlayerStatus::FOLDED;
-        
-        // 如果比牌前只剩两名玩家，则第二个玩家获得所有奖池并结束游戏
-        if (activePlayers == 2) {
-            // 将赢家的下注金额加到余额上
-            player2.money += player2.currentBet;
-            // 将奖池中的入场费加到赢家余额上
-            player2.money += pot;
-            pot = 0;
-            
-            // 游戏结束
-            gameInProgress = false;
-            startButton->setText(players.empty() ? "开始游戏" : "继续游戏");  // 根据是否有玩家设置按钮文本
-            startButton->setEnabled(true);                   // 启用开始游戏按钮
-            lookButton->setEnabled(false);                   // 禁用看牌按钮
-            betButton->setEnabled(false);                    // 禁用下注按钮
-            foldButton->setEnabled(false);                   // 禁用弃牌按钮
-            requestShowdownButton->setEnabled(false);        // 禁用请求开牌按钮
-            
-            // 显示游戏结束消息
-            QMessageBox::information(this, "游戏结束",
-                                   QString::fromStdString(player2.name + " 获胜!"));
-        }
-    }
-    
     // 显示对话框
     resultDialog.exec();                             // 显示对话框并等待用户关闭
     
@@ -628,7 +517,8 @@ void GoldenFlowerWindow::showComparisonDialog(int player1Index, int player2Index
 // 开始新游戏
 void GoldenFlowerWindow::startNewGame() {
     // 检查是否是第一次开始游戏
-    bool isFirstGame = players.empty();
+    bool isFirstGame = table.state().seatCount == 0;
+    int entranceFee;  // 本局入场费
     
     if (isFirstGame) {
         // 获取玩家数量、初始金额和入场费
@@ -648,36 +538,24 @@ void GoldenFlowerWindow::startNewGame() {
                                          minBet, 1, initialMoney / 10, 1, &ok);
         if (!ok) return;  // 用户取消，直接返回
         
-        // 初始化玩家
-        players.clear();  // 清空玩家列表
-        for (int i = 0; i < numPlayers; ++i) {
-            players.emplace_back("玩家" + to_string(i+1), initialMoney);  // 创建玩家对象并添加到列表
-        }
+        table.seatPlayers(numPlayers, initialMoney);  // 初始化玩家
     } else {
         // 如果不是第一次开始游戏，保留玩家余额，只重置其他状态
         // 弹出对话框获取入场费，默认为当前入场费，范围1-最小玩家余额的十分之一
-        int minPlayerMoney = INT_MAX;
-        for (const auto& player : players) {
-            minPlayerMoney = min(minPlayerMoney, player.money);
-        }
-        
         bool ok;
         entranceFee = QInputDialog::getInt(this, "新游戏", "请输入入场费:",
-                                         entranceFee, 1, minPlayerMoney / 10, 1, &ok);
+                                         table.state().fee, 1, table.state().maxEntranceFee(), 1, &ok);
         if (!ok) return;  // 用户取消，直接返回
     }
     
-    // 随机选择庄家
-    int dealerIndex = rand() % players.size();  // 随机生成庄家索引
-    
-    // 重置所有玩家的庄家状态
-    for (auto& player : players) {
-        player.isDealer = false;
+    // 收取入场费、随机选择庄家并发牌，庄家先说话
+    try {
+        table.startHand(entranceFee);
+    } catch (const invalid_argument& e) {
+        QMessageBox::warning(this, "无法开局", QString::fromStdString(e.what()));  // 例如有玩家余额不足以支付入场费
+        return;
     }
     
-    players[dealerIndex].isDealer = true;   // 设置选中的玩家为庄家
-    currentPlayerIndex = dealerIndex;       // 设置当前玩家为庄家
-    
     // 启用游戏按钮
     lookButton->setEnabled(true);           // 启用看牌按钮
     betButton->setEnabled(true);            // 启用下注按钮
@@ -685,49 +563,6 @@ void GoldenFlowerWindow::startNewGame() {
     requestShowdownButton->setEnabled(true); // 启用请求开牌按钮
     startButton->setEnabled(false);         // 禁用开始游戏按钮
     
-    gameInProgress = true;  // 设置游戏进行中标志
-    setupGame();            // 设置游戏（发牌等）
-}
-
-// 设置游戏（初始化牌局）
-/**
- * 设置游戏 - 初始化游戏环境，包括清理上一局数据、创建牌组、洗牌和发牌
- * 在每局游戏开始时调用，为所有玩家准备新的牌局
- */
-void GoldenFlowerWindow::setupGame() {
-    // 清理上一局数据
-    pot = 0;  // 清空奖池
-    for (auto& player : players) {
-        player.reset();  // 重置玩家状态（清空手牌、下注额等）
-        // 收取入场费，但不计入下注总额
-        player.money -= entranceFee;  // 从玩家余额中扣除入场费
-    }
-    
-    // 创建一副完整的扑克牌
-    vector<string> deck;  // 牌组
-    vector<string> suits = {"Hearts", "Spades", "Diamonds", "Clubs"};  // 花色：红桃、黑桃、方块、梅花
-    vector<string> ranks = {"2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K", "A"};  // 点数：2-A
-    
-    // 生成52张牌
-    for (const auto& suit : suits) {
-        for (const auto& rank : ranks) {
-            deck.push_back(rank + " of " + suit);  // 组合花色和点数生成牌
-        }
-    }
-    
-    // 洗牌
-    random_shuffle(deck.begin(), deck.end());  // 随机打乱牌组顺序
-    
-    // 发牌
-    for (int i = 0; i < 3; ++i) { // 每个玩家发3张牌
-        for (auto& player : players) {
-            if (!deck.empty()) {  // 确保牌组不为空
-                player.receiveCard(deck.back());  // 从牌组末尾取一张牌给玩家
-                deck.pop_back();  // 从牌组中移除已发出的牌
-            }
-        }
-    }
-    
     updateUI();  // 更新用户界面
 }
 
@@ -761,7 +596,7 @@ void GoldenFlowerWindow::updateUI() {
     // 获取奖池信息标签
     QLabel* potInfoLabel = centralWidget->findChild<QLabel*>("potInfoLabel");  // 查找奖池信息标签
     if (potInfoLabel) {
-        potInfoLabel->setText(QString("底 : %1\n总 : %2").arg(entranceFee).arg(pot));  // 更新奖池信息文本
+        potInfoLabel->setText(QString("底 : %1\n总 : %2").arg(table.state().fee).arg(table.state().pot));  // 更新奖池信息文本
         // 应用缩放因子到字体大小
         QFont font = potInfoLabel->font();
         font.setPointSizeF(16 * scaleFactor);
@@ -779,13 +614,13 @@ void GoldenFlowerWindow::updateUI() {
     QPoint tableCenter = tableBackground->mapTo(centralWidget, QPoint(tableWidth/2, tableHeight/2));  // 计算牌桌中心点在主窗口中的坐标
     
     // 获取玩家数量
-    int numPlayers = static_cast<int>(players.size());  // 获取当前玩家数量
+    const TableState& state = table.state();
+    int numPlayers = state.seatCount;  // 获取当前玩家数量
     
     // 计算玩家位置，确保均匀分布在矩形牌桌周围
     for (int i = 0; i < numPlayers; ++i) {
-        const Player& player = players[i];  // 获取当前玩家引用
         QString statusText;  // 玩家状态文本
-        switch (player.status) {
+        switch (state.status[i]) {
             case PlayerStatus::LOOKED: statusText = "已看牌"; break;  // 玩家已看牌
             case PlayerStatus::FOLDED: statusText = "已弃牌"; break;  // 玩家已弃牌
             case PlayerStatus::BLIND: statusText = "蒙牌"; break;    // 玩家蒙牌中
@@ -800,11 +635,11 @@ void GoldenFlowerWindow::updateUI() {
         
         // 创建玩家信息标签
         QString info = QString("%1\n￥%2")  // 格式化玩家信息文本
-                      .arg(QString::fromStdString(player.name))  // 添加玩家名称
-                      .arg(player.money);  // 添加玩家金额
+                      .arg(QString::fromStdString(table.name(i)))  // 添加玩家名称
+                      .arg(state.money[i]);  // 添加玩家金额
         
         // 如果是庄家，添加庄家标识
-        if (player.isDealer) {
+        if (state.isDealer(i)) {
             info += "\n(庄家)";
         }
         
@@ -821,7 +656,7 @@ void GoldenFlowerWindow::updateUI() {
         infoLabel->setFont(font);
         
         // 设置标签样式
-        if (static_cast<int>(i) == currentPlayerIndex) {
+        if (i == state.current) {
             infoLabel->setStyleSheet("color: yellow; background-color: rgba(0, 0, 0, 100); padding: 5px; border-radius: 5px;");  // 当前玩家使用黄色文字
         } else {
             infoLabel->setStyleSheet("color: white; background-color: rgba(0, 0, 0, 100); padding: 5px; border-radius: 5px;");  // 其他玩家使用白色文字
@@ -933,11 +768,10 @@ void GoldenFlowerWindow::updateUI() {
             cardLabel->setStyleSheet("border: none;");  // 移除边框
             
             // 如果是当前玩家且已看牌，或者游戏已结束，显示实际牌面
-            if ((static_cast<int>(i) == currentPlayerIndex && player.status == PlayerStatus::LOOKED) || 
-                !gameInProgress) {
-                if (j < player.cards.size()) {  // 确保玩家有足够的牌
-                    // 从卡牌字符串创建Card对象
-                    Card card(player.cards[j]);  // 创建卡牌对象
+            if ((i == state.current && state.status[i] == PlayerStatus::LOOKED) || 
+                !state.playing) {
+                if (state.dealt) {  // 确保已经发过牌
+                    const Card& card = state.hands[i][j];  // 获取卡牌
                     // 获取卡牌图片路径
                     QString imagePath = QString("d:/PokerServer/高清全套扑克牌/PNG/%1")
                                        .arg(QString::fromStdString(card.getImageFileName()));  // 构建图片路径
@@ -981,9 +815,8 @@ void GoldenFlowerWindow::updateUI() {
 
 // 看牌功能实现 - 当玩家点击看牌按钮时调用
 void GoldenFlowerWindow::lookCards() {
-    Player& currentPlayer = players[currentPlayerIndex];  // 获取当前玩家引用
-    if (currentPlayer.status == PlayerStatus::BLIND) {  // 如果当前玩家处于蒙牌状态
-        currentPlayer.status = PlayerStatus::LOOKED;    // 将玩家状态更改为已看牌
+    const Hand& cards = table.state().hands[table.state().current];  // 当前玩家的手牌
+    if (table.look() == ActionStatus::OK) {  // 蒙牌的玩家才能看牌，状态更改为已看牌
         
         // 创建一个对话框来显示牌的图片
         QDialog cardDialog(this);                       // 创建对话框
@@ -999,8 +832,7 @@ void GoldenFlowerWindow::lookCards() {
         layout->setSpacing(int(8 * scaleFactor));          // 设置卡牌间距，应用缩放因子
         
         // 显示玩家的牌
-        for (const auto& cardStr : currentPlayer.cards) {    // 遍历玩家手中的每张牌
-            Card card(cardStr);                             // 从字符串创建Card对象
+        for (const Card& card : cards) {       // 遍历玩家手中的每张牌
             QLabel* cardLabel = new QLabel();               // 创建标签用于显示卡牌
             
             // 根据缩放因子调整卡牌大小
@@ -1040,289 +872,29 @@ void GoldenFlowerWindow::lookCards() {
 
 // 下注功能实现 - 当玩家点击下注按钮时调用
 void GoldenFlowerWindow::placeBet() {
-    Player& currentPlayer = players[currentPlayerIndex];  // 获取当前玩家引用
-    
-    // 如果玩家没有选择看牌，则默认为继续蒙牌状态
-    if (currentPlayer.status == PlayerStatus::WAITING) {
-        currentPlayer.status = PlayerStatus::BLIND;      // 设置玩家状态为蒙牌
-    }
-    
-    // 获取上家索引（跳过已弃牌的玩家）
-    int prevPlayerIndex = (currentPlayerIndex - 1 + players.size()) % players.size();  // 计算上一个玩家的索引
-    while (players[prevPlayerIndex].status == PlayerStatus::FOLDED) {  // 如果上家已弃牌，继续向前查找
-        prevPlayerIndex = (prevPlayerIndex - 1 + players.size()) % players.size();  // 继续向前查找未弃牌的玩家
-    }
-    
-    // 计算最小下注额
-    int minBetAmount;  // 声明最小下注额变量
-    
-    // 如果是庄家且是第一次下注
-    if (currentPlayer.isDealer && currentPlayer.currentBet == 0) {
-        minBetAmount = entranceFee;  // 庄家首次下注至少等于入场费
-    } else {
-        Player& prevPlayer = players[prevPlayerIndex];  // 获取上家引用
-        
-        // 重新实现最小下注金额计算逻辑
-        // 根据玩家状态(蒙牌/看牌)和上家下注金额确定最小下注额
-        if (currentPlayer.status == PlayerStatus::BLIND) {
-            // 如果玩家是蒙牌，则最小下注金额是上家下注金额的一半
-            minBetAmount = (prevPlayer.currentRoundBet + 1) / 2;  // 向上取整
-        } else if (currentPlayer.status == PlayerStatus::LOOKED) {
-            // 如果玩家是看牌，则最小下注金额是上家下注金额
-            minBetAmount = prevPlayer.currentRoundBet;
-        } else {
-            // 其他情况，保持原有逻辑
-            minBetAmount = prevPlayer.currentRoundBet;
-        }
-    }
+    // 下注范围由牌桌按庄家首注、蒙牌/看牌和上家下注算好；余额不足时只能全押
+    const LegalActions& legal = table.state().legal;
+    int minBetAmount = legal.minBet;
     
     // 弹出对话框让玩家输入下注金额
     bool ok;  // 用于存储对话框结果
     int betAmount = QInputDialog::getInt(this, "下注",  // 创建整数输入对话框
                                        QString("请输入下注金额(最小%1):").arg(minBetAmount),  // 设置提示文本
-                                       minBetAmount, minBetAmount, currentPlayer.money, 1, &ok);  // 设置默认值、最小值、最大值和步长
+                                       minBetAmount, minBetAmount, legal.maxBet, 1, &ok);  // 设置默认值、最小值、最大值和步长
     
     if (ok) {  // 如果玩家确认下注
-        currentPlayer.placeBet(betAmount);  // 玩家下注指定金额
-        pot += betAmount;                   // 将下注金额添加到奖池
-        
-        // 检查是否只剩两个玩家，且当前玩家请求了开牌
-        int activePlayers = 0;
-        int otherPlayerIndex = -1;
-        for (size_t i = 0; i < players.size(); ++i) {
-            if (players[i].status != PlayerStatus::FOLDED) {
-                activePlayers++;
-                if (i != currentPlayerIndex) {
-                    otherPlayerIndex = i;
-                }
-            }
-        }
-        
-        nextPlayer();                       // 切换到下一个玩家
-        updateUI();                         // 更新游戏界面
+        table.bet(betAmount);  // 下注并切换到下一个玩家（未看牌的玩家视为蒙牌）
+        updateUI();            // 更新游戏界面
     }
 }
 
 // 弃牌功能实现 - 当玩家点击弃牌按钮时调用
 void GoldenFlowerWindow::fold() {
-    players[currentPlayerIndex].status = PlayerStatus::FOLDED;  // 将当前玩家状态设置为已弃牌
-    nextPlayer();  // 切换到下一个玩家
+    table.fold();  // 弃牌，只剩一个未弃牌的玩家时牌桌直接结算
     updateUI();    // 更新游戏界面
     
-    // 检查是否只剩一个玩家（未弃牌）
-    int activePlayers = 0;       // 初始化活跃玩家计数器
-    int lastActivePlayer = -1;   // 初始化最后一个活跃玩家的索引
-    for (size_t i = 0; i < players.size(); ++i) {  // 遍历所有玩家
-        if (players[i].status != PlayerStatus::FOLDED) {  // 如果玩家未弃牌
-            activePlayers++;                              // 活跃玩家数量加1
-            lastActivePlayer = i;                         // 记录该玩家索引
-        }
-    }
-    
-    if (activePlayers == 1) {  // 如果只剩一个活跃玩家
-        // 游戏结束，最后一个玩家获胜
-        players[lastActivePlayer].money += players[lastActivePlayer].currentBet;  // 返还玩家自己的下注
-        players[lastActivePlayer].money += pot;  // 将奖池金额给予获胜者
-        pot = 0;  // 清空奖池
-        
-        // 显示游戏结束消息
-        QMessageBox::information(this, "游戏结束",
-                               QString::fromStdString(players[lastActivePlayer].name + " 获胜!"));
-        
-        // 重置游戏状态
-        gameInProgress = false;                 // 设置游戏未进行中
-        startButton->setEnabled(true);          // 启用开始游戏按钮
-        lookButton->setEnabled(false);          // 禁用看牌按钮
-        betButton->setEnabled(false);           // 禁用下注按钮
-        foldButton->setEnabled(false);          // 禁用弃牌按钮
-        requestShowdownButton->setEnabled(false);  // 禁用请求开牌按钮
-        
-        updateUI();  // 更新游戏界面
-        return;      // 游戏已结束，直接返回
-    }
-}
-
-// 切换到下一个玩家 - 跳过已弃牌的玩家
-void GoldenFlowerWindow::nextPlayer() {
-    do {
-        // 循环到下一个玩家，使用取模运算确保索引在有效范围内
-        currentPlayerIndex = (currentPlayerIndex + 1) % players.size();
-    } while (players[currentPlayerIndex].status == PlayerStatus::FOLDED);  // 如果下一个玩家已弃牌，继续循环
-}
-
-/**
- * 评估手牌类型 - 判断玩家手中的牌属于哪种牌型
- * 炸金花游戏中的牌型从高到低依次为：豹子、同花顺、同花、顺子、对子、高牌
- * 另有特殊牌型235（不同花色的2、3、5组合）
- * @param cardStrs 玩家手牌的字符串表示数组
- * @return 判断出的牌型枚举值
- */
-CardType GoldenFlowerWindow::evaluateHand(const vector<string>& cardStrs) {
-    vector<Card> cards;  // 创建Card对象数组
-    for (const auto& cardStr : cardStrs) {  // 遍历所有牌字符串
-        cards.push_back(Card(cardStr));     // 将字符串转换为Card对象并添加到数组
-    }
-    
-    // 检查豹子（三张相同点数的牌）
-    if (Card::isThreeOfAKind(cards)) {
-        return CardType::THREE_OF_KIND;  // 返回豹子牌型
-    }
-    
-    // 检查是否同花和顺子
-    bool isFlush = Card::isFlush(cards);      // 检查是否为同花（三张相同花色的牌）
-    bool isStraight = Card::isStraight(cards);  // 检查是否为顺子（三张连续点数的牌）
-    
-    // 检查同花顺（既是同花又是顺子）
-    if (isFlush && isStraight) {
-        return CardType::STRAIGHT_FLUSH;  // 返回同花顺牌型
-    }
-    
-    // 检查同花
-    if (isFlush) {
-        return CardType::FLUSH;  // 返回同花牌型
-    }
-    
-    // 检查顺子
-    if (isStraight) {
-        return CardType::STRAIGHT;  // 返回顺子牌型
-    }
-    
-    // 检查对子（两张相同点数的牌）
-    if (Card::isPair(cards)) {
-        return CardType::PAIR;  // 返回对子牌型
-    }
-    
-    // 检查特殊235牌型（特殊规则：2、3、5不同花色组成的牌）
-    if (Card::isSpecial235(cards)) {
-        return CardType::SPECIAL_235;  // 返回特殊235牌型
-    }
-    
-    // 如果以上都不是，则为高牌
-    return CardType::HIGH_CARD;  // 返回高牌牌型
-}
-
-/**
- * 比较两手牌的大小 - 实现炸金花游戏的牌型大小比较逻辑
- * 按照牌型大小顺序：豹子 > 同花顺 > 同花 > 顺子 > 对子 > 单张
- * 特殊规则：235组合可以反杀豹子，但输给其他所有牌型
- * @param hand1Strs 第一手牌的字符串表示
- * @param hand2Strs 第二手牌的字符串表示
- * @return true表示hand1大于hand2，false表示hand1小于等于hand2
- */
-bool GoldenFlowerWindow::compareHands(const vector<string>& hand1Strs, const vector<string>& hand2Strs) {
-    vector<Card> hand1, hand2;  // 创建两个Card对象数组
-    
-    // 将第一手牌的字符串转换为Card对象
-    for (const auto& cardStr : hand1Strs) {
-        hand1.push_back(Card(cardStr));  // 将字符串转换为Card对象并添加到数组
-    }
-    
-    // 将第二手牌的字符串转换为Card对象
-    for (const auto& cardStr : hand2Strs) {
-        hand2.push_back(Card(cardStr));  // 将字符串转换为Card对象并添加到数组
-    }
-    
-    // 评估两手牌的牌型
-    CardType type1 = evaluateHand(hand1Strs);  // 评估第一手牌的牌型
-    CardType type2 = evaluateHand(hand2Strs);  // 评估第二手牌的牌型
-    
-    // 处理特殊235反杀豹子的规则
-    if (type1 == CardType::SPECIAL_235 && type2 == CardType::THREE_OF_KIND) {
-        return true;  // 235反杀豹子
-    }
-    if (type2 == CardType::SPECIAL_235 && type1 == CardType::THREE_OF_KIND) {
-        return false;  // 豹子被235反杀
-    }
-    
-    // 特殊235输给除豹子外的任何牌型
-    if (type1 == CardType::SPECIAL_235 && type2 != CardType::THREE_OF_KIND) {
-        return false;
-    }
-    if (type2 == CardType::SPECIAL_235 && type1 != CardType::THREE_OF_KIND) {
-        return true;
-    }
-    
-    // 如果牌型不同，直接比较牌型大小
-    if (type1 != type2) {
-        return static_cast<int>(type1) > static_cast<int>(type2);  // 将枚举转换为整数进行比较
-    }
-    
-    // 牌型相同时的比较逻辑
-    sort(hand1.begin(), hand1.end());  // 对第一手牌进行排序
-    sort(hand2.begin(), hand2.end());  // 对第二手牌进行排序
-    
-    switch (type1) {  // 根据牌型选择不同的比较策略
-        case CardType::THREE_OF_KIND: {
-            // 豹子比较点数
-            if (hand1[0].getRank() != hand2[0].getRank()) {
-                return static_cast<int>(hand1[0].getRank()) > static_cast<int>(hand2[0].getRank());
-            }
-            // 点数相同比较花色（红桃 > 黑桃 > 方块 > 梅花）
-            return static_cast<int>(hand1[0].getSuit()) < static_cast<int>(hand2[0].getSuit());
-        }
-            
-        case CardType::STRAIGHT_FLUSH:
-        case CardType::STRAIGHT: {
-            // 顺子或同花顺比较最大牌
-            if (hand1[2].getRank() != hand2[2].getRank()) {  // 如果最大牌点数不同
-                return static_cast<int>(hand1[2].getRank()) > static_cast<int>(hand2[2].getRank());
-            }
-            // 点数相同比较花色（红桃 > 黑桃 > 方块 > 梅花）
-            return static_cast<int>(hand1[2].getSuit()) < static_cast<int>(hand2[2].getSuit());
-        }
-            
-        case CardType::FLUSH: {
-            // 同花从大到小比较每张牌
-            for (int i = 2; i >= 0; --i) {  // 从最大牌开始比较
-                if (hand1[i].getRank() != hand2[i].getRank()) {  // 如果点数不同
-                    return static_cast<int>(hand1[i].getRank()) > static_cast<int>(hand2[i].getRank());
-                }
-            }
-            // 所有点数都相同，比较最大牌的花色（红桃 > 黑桃 > 方块 > 梅花）
-            return static_cast<int>(hand1[2].getSuit()) < static_cast<int>(hand2[2].getSuit());
-        }
-            
-        case CardType::PAIR: {
-            // 找出对子和单牌
-            Card pair1, pair2, single1, single2;  // 声明变量用于存储对子和单牌
-            for (int i = 0; i < 2; ++i) {  // 遍历前两张牌
-                if (hand1[i].getRank() == hand1[i+1].getRank()) {  // 如果找到对子
-                    pair1 = hand1[i];  // 记录对子
-                    single1 = (i == 0) ? hand1[2] : hand1[0];  // 记录单牌
-                    break;
-                }
-            }
-            for (int i = 0; i < 2; ++i) {  // 遍历前两张牌
-                if (hand2[i].getRank() == hand2[i+1].getRank()) {  // 如果找到对子
-                    pair2 = hand2[i];  // 记录对子
-                    single2 = (i == 0) ? hand2[2] : hand2[0];  // 记录单牌
-                    break;
-                }
-            }
-            if (pair1.getRank() != pair2.getRank()) {  // 如果对子点数不同
-                return static_cast<int>(pair1.getRank()) > static_cast<int>(pair2.getRank());
-            }
-            if (single1.getRank() != single2.getRank()) {  // 如果单牌点数不同
-                return static_cast<int>(single1.getRank()) > static_cast<int>(single2.getRank());
-            }
-            // 对子和单牌点数都相同，比较对子的花色（红桃 > 黑桃 > 方块 > 梅花）
-            return static_cast<int>(pair1.getSuit()) < static_cast<int>(pair2.getSuit());
-        }
-            
-        case CardType::HIGH_CARD: {
-            // 从大到小比较每张牌
-            for (int i = 2; i >= 0; --i) {  // 从最大牌开始比较
-                if (hand1[i].getRank() != hand2[i].getRank()) {  // 如果点数不同
-                    return static_cast<int>(hand1[i].getRank()) > static_cast<int>(hand2[i].getRank());
-                }
-            }
-            // 所有点数都相同，比较最大牌的花色（红桃 > 黑桃 > 方块 > 梅花）
-            return static_cast<int>(hand1[2].getSuit()) < static_cast<int>(hand2[2].getSuit());
-        }
-            
-        default: {
-            return false;  // 默认情况下返回false
-        }
+    if (!table.state().playing) {  // 游戏结束，最后一个玩家获胜
+        endGame();
     }
 }
 
@@ -1339,61 +911,27 @@ bool GoldenFlowerWindow::compareHands(const vector<string>& hand1Strs, const vec
  * 比牌需要额外下注，输者自动弃牌，如果只剩最后一名玩家则游戏结束
  */
 void GoldenFlowerWindow::requestShowdown() {
-    Player& currentPlayer = players[currentPlayerIndex];  // 获取当前玩家引用
-    
-    // 计算当前最小下注金额
-    int minBetAmount = 0;
-    
-    // 获取上家索引（跳过已弃牌的玩家）
-    int prevPlayerIndex = (currentPlayerIndex - 1 + players.size()) % players.size();
-    while (players[prevPlayerIndex].status == PlayerStatus::FOLDED) {
-        prevPlayerIndex = (prevPlayerIndex - 1 + players.size()) % players.size();
-    }
-    
-    // 计算最小下注额
-    // 如果是庄家且是第一次下注
-    if (currentPlayer.isDealer && currentPlayer.currentBet == 0) {
-        // 如果玩家一开始就选择开牌
-        if (currentPlayer.status == PlayerStatus::LOOKED) {
-            // 看牌状态，开牌金额是入场费的两倍
-            minBetAmount = entranceFee * 2;
-        } else {
-            // 蒙牌状态，开牌金额是入场费
-            minBetAmount = entranceFee;
-        }
-    } else {
-        Player& prevPlayer = players[prevPlayerIndex];
-        // 根据上家和当前玩家的状态决定最小下注额
-        if (prevPlayer.status == PlayerStatus::BLIND && currentPlayer.status == PlayerStatus::LOOKED) {
-            // 上家蒙牌，当前玩家看牌，需要下注大于等于上家当轮下注的两倍
-            minBetAmount = prevPlayer.currentRoundBet * 2;
-        } else if (prevPlayer.status == PlayerStatus::LOOKED && currentPlayer.status == PlayerStatus::BLIND) {
-            // 上家看牌，当前玩家蒙牌，需要下注大于等于上家当轮下注的一半
-            minBetAmount = (prevPlayer.currentRoundBet + 1) / 2;  // 向上取整
-        } else {
-            // 其他情况（都看牌或都蒙牌），需要下注大于等于上家当轮下注的金额
-            minBetAmount = prevPlayer.currentRoundBet;
-        }
-        
-        // 请求开牌需要下注最小下注金额的两倍
-        minBetAmount = minBetAmount * 2;
-    }
+    const TableState& state = table.state();
+    const LegalActions& legal = state.legal;
+    int currentPlayerIndex = state.current;  // 发起比牌的玩家
     
-    // 设置开牌所需的下注金额
-    int betAmount = minBetAmount;
+    // 开牌所需的下注金额由牌桌按双方的看牌状态算好
+    int betAmount = legal.showdownCost;
     
     // 检查玩家资金是否足够请求开牌
-    if (currentPlayer.money < betAmount) {
+    if (!legal.canShowdown) {
         QMessageBox::warning(this, "资金不足", "您的资金不足以请求开牌。");  // 显示警告消息
         return;  // 资金不足，直接返回
     }
 
     // 获取可选择的玩家列表（排除当前玩家和已弃牌的玩家）
     QStringList playerOptions;  // 创建玩家选项列表
-    for (size_t i = 0; i < players.size(); ++i) {  // 遍历所有玩家
-        if (i != currentPlayerIndex && players[i].status != PlayerStatus::FOLDED) {  // 如果不是当前玩家且未弃牌
-            playerOptions << QString::fromStdString(players[i].name);  // 将玩家名称添加到选项列表
-        }
+    vector<int> optionIndices;  // 选项对应的玩家索引
+    // 逐个取出可比牌对象掩码中的位
+    for (uint64_t rest = legal.targets; rest != 0; rest &= rest - 1) {
+        int i = countTrailingZeros64(rest);
+        playerOptions << QString::fromStdString(table.name(i));  // 将玩家名称添加到选项列表
+        optionIndices.push_back(i);
     }
     
     // 检查是否有可选择的玩家
@@ -1402,14 +940,6 @@ void GoldenFlowerWindow::requestShowdown() {
         return;  // 无效操作，直接返回
     }
     
-    // 检查是否只剩两个玩家
-    int activePlayers = 0;
-    for (const auto& player : players) {
-        if (player.status != PlayerStatus::FOLDED) {
-            activePlayers++;
-        }
-    }
-    
     // 弹出对话框让玩家选择要比牌的对手
     bool ok;  // 用于存储对话框结果
     QString selectedPlayer = QInputDialog::getItem(this, "请求开牌",  // 创建列表选择对话框
@@ -1418,160 +948,36 @@ void GoldenFlowerWindow::requestShowdown() {
     if (!ok) return;  // 如果玩家取消选择，直接返回
     
     // 找到选择的玩家索引
-    int targetPlayerIndex = -1;  // 初始化目标玩家索引为-1（无效值）
-    for (size_t i = 0; i < players.size(); ++i) {  // 遍历所有玩家
-        if (QString::fromStdString(players[i].name) == selectedPlayer) {  // 如果找到选择的玩家
-            targetPlayerIndex = i;  // 记录目标玩家索引
-            break;  // 找到后跳出循环
-        }
-    }
-    
-    if (targetPlayerIndex == -1) return;  // 如果没有找到目标玩家，直接返回
+    int targetPlayerIndex = optionIndices[playerOptions.indexOf(selectedPlayer)];
 
-    // 如果只剩两个玩家，添加确认界面
-    if (activePlayers == 2) {
+    // 如果只剩两个玩家，比牌即决定胜负，添加确认界面
+    if (state.activeCount() == 2) {
         // 创建确认对话框
         QMessageBox confirmBox(this);
         confirmBox.setWindowTitle("确认开牌");
-        confirmBox.setText(QString::fromStdString(currentPlayer.name) + " 请求与 " + 
-                          QString::fromStdString(players[targetPlayerIndex].name) + " 开牌。");
+        confirmBox.setText(QString::fromStdString(table.name(currentPlayerIndex)) + " 请求与 " + 
+                          QString::fromStdString(table.name(targetPlayerIndex)) + " 开牌。");
         confirmBox.setInformativeText(QString("确定要开牌吗？需要下注 %1 金额").arg(betAmount));
         confirmBox.setStandardButtons(QMessageBox::Ok | QMessageBox::Cancel);
         confirmBox.setDefaultButton(QMessageBox::Ok);
         
-        // 显示确认对话框并获取结果
-        int ret = confirmBox.exec();
-        
-        // 如果用户点击确定，进行比牌
-        if (ret == QMessageBox::Ok) {
-            // 下注请求开牌所需金额
-            currentPlayer.placeBet(betAmount);        // 当前玩家下注
-            pot += betAmount;                         // 将下注金额添加到奖池
-            
-            // 比较两手牌的大小
-            bool currentPlayerWins = compareHands(currentPlayer.cards, players[targetPlayerIndex].cards);
-            
-            // 显示比牌结果对话框
-            showComparisonDialog(currentPlayerIndex, targetPlayerIndex);
-            
-            // 输者弃牌
-            if (currentPlayerWins) {
-                // 目标玩家输，设置为弃牌状态
-                players[targetPlayerIndex].status = PlayerStatus::FOLDED;
-            } else {
-                // 当前玩家输，设置为弃牌状态
-                currentPlayer.status = PlayerStatus::FOLDED;
-            }
-            
-            // 检查是否只剩一个活跃玩家，如果是则游戏结束
-            int remainingPlayers = 0;
-            int lastActivePlayer = -1;
-            for (size_t i = 0; i < players.size(); ++i) {
-                if (players[i].status != PlayerStatus::FOLDED) {
-                    remainingPlayers++;
-                    lastActivePlayer = i;
-                }
-            }
-            
-            if (remainingPlayers == 1) {
-                // 游戏结束，最后一个玩家获胜
-                // 将奖池金额给予获胜者，还要加上其余人的入场费
-                players[lastActivePlayer].money += pot;  // 将奖池金额给予获胜者
-                
-                // 计算入场费总额（除了获胜者以外的所有玩家的入场费）
-                int totalEntranceFee = 0;
-                for (size_t i = 0; i < players.size(); ++i) {
-                    if (i != lastActivePlayer) {
-                        totalEntranceFee += entranceFee;
-                    }
-                }
-                
-                // 将入场费总额加给获胜者
-                players[lastActivePlayer].money += totalEntranceFee;
-                
-                pot = 0;  // 清空奖池
-                
-                QMessageBox::information(this, "游戏结束",
-                                      QString::fromStdString(players[lastActivePlayer].name + " 获胜!"));
-                gameInProgress = false;
-                startButton->setEnabled(true);
-                lookButton->setEnabled(false);
-                betButton->setEnabled(false);
-                foldButton->setEnabled(false);
-                requestShowdownButton->setEnabled(false);
-                
-                updateUI();
-                return;  // 游戏已结束，直接返回
-            }
-            
-            // 轮到下家说话下注
-            nextPlayer();
-            updateUI();
-        }
-    } else {
-        // 下注请求开牌所需金额
-        currentPlayer.placeBet(betAmount);        // 当前玩家下注
-        pot += betAmount;                         // 将下注金额添加到奖池
-        
-        // 比较两手牌的大小
-        bool currentPlayerWins = compareHands(currentPlayer.cards, players[targetPlayerIndex].cards);
-        
-        // 显示比牌结果对话框
-        showComparisonDialog(currentPlayerIndex, targetPlayerIndex);
-        
-        // 输者弃牌
-        if (currentPlayerWins) {
-            // 目标玩家输，设置为弃牌状态
-            players[targetPlayerIndex].status = PlayerStatus::FOLDED;
-        } else {
-            // 当前玩家输，设置为弃牌状态
-            currentPlayer.status = PlayerStatus::FOLDED;
-        }
-        
-        // 检查是否只剩一个活跃玩家，如果是则游戏结束
-        int remainingPlayers = 0;
-        int lastActivePlayer = -1;
-        for (size_t i = 0; i < players.size(); ++i) {
-            if (players[i].status != PlayerStatus::FOLDED) {
-                remainingPlayers++;
-                lastActivePlayer = i;
-            }
+        // 显示确认对话框，用户取消则不比牌
+        if (confirmBox.exec() != QMessageBox::Ok) {
+            return;
         }
-        
-        if (remainingPlayers == 1) {
-            // 游戏结束，最后一个玩家获胜
-            // 将奖池金额给予获胜者，还要加上其余人的入场费
-            players[lastActivePlayer].money += pot;  // 将奖池金额给予获胜者
-            
-            // 计算入场费总额（除了获胜者以外的所有玩家的入场费）
-            int totalEntranceFee = 0;
-            for (size_t i = 0; i < players.size(); ++i) {
-                if (i != lastActivePlayer) {
-                    totalEntranceFee += entranceFee;
-                }
-            }
-            
-            // 将入场费总额加给获胜者
-            players[lastActivePlayer].money += totalEntranceFee;
-            
-            pot = 0;  // 清空奖池
-            
-            QMessageBox::information(this, "游戏结束",
-                                  QString::fromStdString(players[lastActivePlayer].name + " 获胜!"));
-            gameInProgress = false;
-            startButton->setEnabled(true);
-            lookButton->setEnabled(false);
-            betButton->setEnabled(false);
-            foldButton->setEnabled(false);
-            requestShowdownButton->setEnabled(false);
-            
-            updateUI();
-            return;  // 游戏已结束，直接返回
-        }
-        
-        // 轮到下家说话下注
-        nextPlayer();
-        updateUI();
+    }
+    
+    // 下注请求开牌所需金额并比牌，输者弃牌；只剩一个活跃玩家时牌桌结算，否则轮到下家
+    ShowdownOutcome outcome;
+    if (table.showdown(targetPlayerIndex, outcome) != ActionStatus::OK) {
+        return;
+    }
+    
+    // 显示比牌结果对话框
+    showComparisonDialog(currentPlayerIndex, targetPlayerIndex, outcome.winner);
+    
+    if (!state.playing) {  // 游戏已结束
+        endGame();
     }
 }
 
@@ -1583,37 +989,16 @@ void GoldenFlowerWindow::requestShowdown() {
 
 
 /**
- * 结束游戏 - 处理游戏结束逻辑
- * @param winnerIndex 获胜玩家的索引
+ * 结束游戏 - 牌桌结算后显示获胜者并恢复按钮状态
+ * 奖池和入场费已由GameTable分给获胜者
  */
-void GoldenFlowerWindow::endGame(int winnerIndex) {
-    // 检查索引是否有效
-    if (winnerIndex < 0 || winnerIndex >= players.size()) {
-        return;
-    }
-    
-    // 将奖池金额给予获胜者
-    players[winnerIndex].money += pot;
-    
-    // 计算入场费总额（除了获胜者以外的所有玩家的入场费）
-    int totalEntranceFee = 0;
-    for (size_t i = 0; i < players.size(); ++i) {
-        if (i != winnerIndex) {
-            totalEntranceFee += entranceFee;
-        }
-    }
-    
-    // 将入场费总额加给获胜者
-    players[winnerIndex].money += totalEntranceFee;
-    
-    pot = 0;  // 清空奖池
-    
+void GoldenFlowerWindow::endGame() {
     // 显示游戏结束消息
     QMessageBox::information(this, "游戏结束",
-                          QString::fromStdString(players[winnerIndex].name + " 获胜!"));
+                          QString::fromStdString(table.name(table.state().winner) + " 获胜!"));
     
     // 更新游戏状态
-    gameInProgress = false;
+    startButton->setText("继续游戏");
     startButton->setEnabled(true);
     lookButton->setEnabled(false);
     betButton->setEnabled(false);
@@ -19,46 +19,12 @@
 #include <QEvent>
 #include <QEnterEvent>
 #include <QTimer>
+#include "Card.h"
+#include "DeckPool.h"
+#include "GameTable.h"
 
 using namespace std;
 
-// 牌型枚举
-enum class CardType {
-    HIGH_CARD,      // 单张
-    PAIR,           // 对子
-    STRAIGHT,       // 顺子
-    FLUSH,          // 同花
-    STRAIGHT_FLUSH, // 同花顺
-    THREE_OF_KIND,  // 豹子
-    SPECIAL_235     // 特殊235
-};
-
-// 玩家状态枚举
-enum class PlayerStatus {
-    WAITING,    // 等待操作
-    FOLDED,     // 已弃牌
-    BLIND,      // 蒙牌
-    LOOKED      // 已看牌
-};
-
-// 玩家类
-class Player {
-public:
-    Player(const string& name, int initialMoney);
-    
-    string name;              // 玩家名称
-    vector<string> cards;     // 手牌
-    int money;               // 当前金额
-    int currentBet;          // 当前总下注
-    int currentRoundBet;     // 当前轮次下注
-    PlayerStatus status;     // 玩家状态
-    bool isDealer;           // 是否为庄家
-    
-    void reset();            // 重置玩家状态
-    void placeBet(int amount); // 下注
-    void receiveCard(const string& card); // 接收一张牌
-};
-
 // 游戏主窗口类
 class GoldenFlowerWindow : public QMainWindow {
     Q_OBJECT
@@ -95,13 +61,10 @@ private:
     QPushButton *requestShowdownButton;
     
     // 游戏逻辑
-    vector<Player> players;
-    int currentPlayerIndex;
-    int pot;                    // 奖池
-    int minBet;                // 最小下注
-    int entranceFee;           // 入场费
-    bool gameInProgress;
+    int minBet;                // 最小下注（第一局入场费的默认值）
     int maxPlayers;            // 最大玩家数
+    DeckPool deckPool;         // 预洗牌池，开局时直接取一副洗好的牌
+    GameTable table;           // 牌桌规则：轮转、下注、比牌和结算；本局牌的种子见table.handSeed()
     
     // 布局调整参数
     int tableWidth;           // 牌桌宽度
@@ -114,13 +77,9 @@ private:
     
     void initializeUI();        // 初始化UI
     void updateUI();            // 更新UI
-    void setupGame();           // 设置游戏
-    void nextPlayer();          // 切换到下一个玩家
-    CardType evaluateHand(const vector<string>& cards); // 评估牌型
-    bool compareHands(const vector<string>& hand1, const vector<string>& hand2); // 比较牌型
     void adjustLayoutParameters(int newTableWidth, int newTableHeight, int newPlayerInfoDistance, int newCardDistance, float newScaleFactor); // 调整布局参数
-    void showComparisonDialog(int player1Index, int player2Index); // 显示比牌结果对话框
-    void endGame(int winnerIndex); // 结束游戏并处理获胜者奖励
+    void showComparisonDialog(int player1Index, int player2Index, int winnerIndex); // 显示比牌结果对话框
+    void endGame();             // 牌局结算后显示获胜者并恢复按钮
     
     // 卡牌交互效果
     void setupCardHoverEffects(); // 设置卡牌悬停效果
@@ -0,0 +1,195 @@
+//
+// Created for self-play simulation
+// 用法：goldenflower-sim [局数] [人数] [入场费] [最小下注额] [策略列表] [初始金额] [牌桌种子] [线程数]
+// 策略列表用逗号分隔，按座位循环分配，例如 tight,random,blind；可用的策略见botPolicyNames
+// 牌局分给固定数目的独立牌桌，每张牌桌是一个TableState，连续打一段牌局，余额不够付入场费时整桌重新买入
+// 第h局的牌由Philox和(种子, h)决定；牌桌数与线程数无关，汇总的整数结果不随线程数和调度变化
+//
+
+#include "BotPolicy.h"
+#include "Deck.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+
+namespace {
+
+const uint64_t DEFAULT_HANDS = 10000000;
+// 独立牌桌的数目，也是线程池的任务数：足够多才能在各线程之间均衡负载
+const int SIM_TABLES = 4096;
+// 一局的操作数上限：超过后轮到的玩家被迫比牌（付不起则弃牌），保证每局都能结束
+const int MAX_ACTIONS_PER_HAND = 256;
+
+// 每线程的累加器，按缓存行对齐
+struct alignas(CACHE_LINE_SIZE) SimTotals {
+    uint64_t wins[MAX_TABLE_SEATS];
+    int64_t net[MAX_TABLE_SEATS];   // 余额的累计变化，含入场费
+    uint64_t hands;
+    uint64_t actions;
+    uint64_t forced;                // 达到操作数上限被迫比牌或弃牌的次数
+    uint64_t illegal;               // 策略给出不合法操作、改为弃牌的次数
+    uint64_t rebuys;
+};
+
+struct SimConfig {
+    uint64_t hands;
+    int players;
+    int entranceFee;
+    int minBet;
+    int initialMoney;
+    uint64_t tableSeed;
+    vector<unique_ptr<BotPolicy>> policies;
+};
+
+// 逗号分隔的策略名称
+vector<unique_ptr<BotPolicy>> parsePolicies(const string& list) {
+    vector<unique_ptr<BotPolicy>> policies;
+    size_t begin = 0;
+    for (;;) {
+        size_t end = list.find(',', begin);
+        policies.push_back(makeBotPolicy(list.substr(begin, end - begin)));
+        if (end == string::npos) {
+            break;
+        }
+        begin = end + 1;
+    }
+    return policies;
+}
+
+void seatTable(TableState& state, const SimConfig& config) {
+    state.seatPlayers(config.players, config.initialMoney);
+    state.setMinimumBet(config.minBet);
+}
+
+/**
+ * 一张牌桌连续打[begin, end)局
+ * @param config 模拟参数
+ * @param table 牌桌编号，决定选庄和机器人的随机流
+ * @param begin 第一局的编号
+ * @param end 最后一局之后的编号
+ * @param totals 本线程的累加器
+ */
+void playTable(const SimConfig& config, int table, uint64_t begin, uint64_t end, SimTotals& totals) {
+    TableState state = TableState();
+    seatTable(state, config);
+    Xoshiro256 rng(config.tableSeed, static_cast<uint64_t>(table));
+    Hand hands[MAX_TABLE_SEATS];
+    int32_t before[MAX_TABLE_SEATS];
+
+    for (uint64_t hand = begin; hand < end; ++hand) {
+        if (state.maxEntranceFee() < config.entranceFee) {
+            seatTable(state, config);
+            ++totals.rebuys;
+        }
+        Deck deck;
+        deck.dealFrom(config.players, hands, ShuffledDeck::fromSeed(RngEngine::PHILOX, DealSeed{config.tableSeed, hand},
+                                                                    deck.shuffleDepth(config.players)));
+        memcpy(before, state.money, sizeof(before));
+        state.startHand(config.entranceFee, hands,
+                        static_cast<int>(uniformBelow(rng, static_cast<uint32_t>(config.players))), false);
+
+        ShowdownOutcome outcome;
+        for (int actions = 0; state.playing; ++actions) {
+            BotAction action;
+            if (actions < MAX_ACTIONS_PER_HAND) {
+                action = config.policies[state.current % config.policies.size()]->decide(state, rng);
+            } else {
+                const LegalActions& legal = state.legal;
+                action = legal.canShowdown ? BotAction{BotMove::SHOWDOWN, 0, countTrailingZeros64(legal.targets)}
+                                           : BotAction{BotMove::FOLD, 0, -1};
+                ++totals.forced;
+            }
+            if (applyBotAction(state, action, outcome) != ActionStatus::OK) {
+                state.fold();
+                ++totals.illegal;
+            }
+            ++totals.actions;
+        }
+
+        for (int seat = 0; seat < config.players; ++seat) {
+            totals.net[seat] += state.money[seat] - before[seat];
+        }
+        ++totals.wins[state.winner];
+        ++totals.hands;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SimConfig config;
+    config.hands = argc > 1 ? strtoull(argv[1], nullptr, 10) : DEFAULT_HANDS;
+    config.players = argc > 2 ? atoi(argv[2]) : 6;
+    config.entranceFee = argc > 3 ? atoi(argv[3]) : 10;
+    config.minBet = argc > 4 ? atoi(argv[4]) : 0;
+    string policyList = argc > 5 ? argv[5] : "tight,random,blind,calling";
+    config.initialMoney = argc > 6 ? atoi(argv[6]) : 1000;
+    config.tableSeed = argc > 7 ? strtoull(argv[7], nullptr, 10) : 0;
+    int threadCount = argc > 8 ? atoi(argv[8]) : 0;
+
+    if (config.hands == 0 || config.players < MIN_TABLE_PLAYERS || config.players > MAX_TABLE_SEATS ||
+        config.entranceFee < 1 || config.minBet < 0 || config.initialMoney < config.entranceFee * 10) {
+        fprintf(stderr, "Usage: %s [hands] [players 2-17] [entranceFee] [minBet] [policy,policy,...] "
+                        "[initialMoney >= 10*entranceFee] [seed] [threads]\n", argv[0]);
+        return 1;
+    }
+
+    vector<SimTotals> perWorker;
+    double seconds = 0.0;
+    int workers = 0;
+    int tables = static_cast<int>(min<uint64_t>(config.hands, SIM_TABLES));
+    try {
+        config.policies = parsePolicies(policyList);
+        ThreadPool pool(threadCount);
+        workers = pool.size();
+        perWorker.resize(workers);
+        memset(perWorker.data(), 0, sizeof(SimTotals) * workers);
+
+        uint64_t hands = config.hands;
+        auto start = chrono::steady_clock::now();
+        pool.parallelFor(tables, [&](int table, int worker) {
+            uint64_t begin = hands / tables * table + min<uint64_t>(table, hands % tables);
+            uint64_t end = begin + hands / tables + (static_cast<uint64_t>(table) < hands % tables ? 1 : 0);
+            playTable(config, table, begin, end, perWorker[worker]);
+        });
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    } catch (const exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    SimTotals total;
+    memset(&total, 0, sizeof(total));
+    for (const SimTotals& local : perWorker) {
+        for (int seat = 0; seat < MAX_TABLE_SEATS; ++seat) {
+            total.wins[seat] += local.wins[seat];
+            total.net[seat] += local.net[seat];
+        }
+        total.hands += local.hands;
+        total.actions += local.actions;
+        total.forced += local.forced;
+        total.illegal += local.illegal;
+        total.rebuys += local.rebuys;
+    }
+
+    double handsPerSecond = seconds > 0.0 ? total.hands / seconds : 0.0;
+    printf("%llu hands, %d players, fee %d, min bet %d, money %d, seed %llu, %d tables on %d threads\n",
+           static_cast<unsigned long long>(total.hands), config.players, config.entranceFee, config.minBet,
+           config.initialMoney, static_cast<unsigned long long>(config.tableSeed), tables, workers);
+    printf("%.2f s, %.0f hands/s (%.2fM hands/min), %.2f actions/hand\n", seconds, handsPerSecond,
+           handsPerSecond * 60.0 / 1e6, static_cast<double>(total.actions) / total.hands);
+    printf("rebuys %llu, forced %llu, illegal %llu\n", static_cast<unsigned long long>(total.rebuys),
+           static_cast<unsigned long long>(total.forced), static_cast<unsigned long long>(total.illegal));
+    printf("%-4s %-8s %12s %8s %10s\n", "seat", "policy", "wins", "win%", "net/hand");
+    for (int seat = 0; seat < config.players; ++seat) {
+        printf("%-4d %-8s %12llu %7.2f%% %10.3f\n", seat, config.policies[seat % config.policies.size()]->name(),
+               static_cast<unsigned long long>(total.wins[seat]), 100.0 * total.wins[seat] / total.hands,
+               static_cast<double>(total.net[seat]) / total.hands);
+    }
+    return 0;
+}
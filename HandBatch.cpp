@@ -0,0 +1,171 @@
+//
+// Created for batch hand evaluation
+// AVX2路径用16位通道一次处理16手牌：三元素排序网络 + 比较掩码逐级混合出牌型和牌力键
+//
+
+#include "HandBatch.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HAND_BATCH_HAS_AVX2 1
+#include <immintrin.h>
+#else
+#define HAND_BATCH_HAS_AVX2 0
+#endif
+
+void evaluateHandBatchScalar(const HandBatch& batch, CardType* types, uint16_t* keys) {
+    for (int i = 0; i < batch.count; ++i) {
+        Hand hand;
+        for (int k = 0; k < 3; ++k) {
+            hand[k] = Card(static_cast<Rank>(batch.ranks[k][i]), static_cast<Suit>(batch.suits[k][i]));
+        }
+        keys[i] = static_cast<uint16_t>(strengthKey(hand, types[i]));
+    }
+}
+
+#if HAND_BATCH_HAS_AVX2
+
+namespace {
+
+const int AVX2_LANES = 16;
+
+// 取出16手牌中第k张牌的排序值：点数(0..12)*4 + (3-花色)
+// 排序值升序即Card::operator<的顺序；低2位正好是牌力键里的花色分量
+__attribute__((target("avx2")))
+inline __m256i loadSortValue(const HandBatch& batch, int k, int offset) {
+    __m256i rank = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.ranks[k] + offset)));
+    __m256i suit = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.suits[k] + offset)));
+    rank = _mm256_sub_epi16(rank, _mm256_set1_epi16(static_cast<int>(Rank::TWO)));
+    return _mm256_or_si256(_mm256_slli_epi16(rank, 2), _mm256_sub_epi16(_mm256_set1_epi16(3), suit));
+}
+
+__attribute__((target("avx2")))
+inline __m256i select16(__m256i mask, __m256i ifTrue, __m256i ifFalse) {
+    return _mm256_blendv_epi8(ifFalse, ifTrue, mask);
+}
+
+__attribute__((target("avx2")))
+void evaluateBlockAvx2(const HandBatch& batch, int offset, CardType* types, uint16_t* keys) {
+    __m256i v0 = loadSortValue(batch, 0, offset);
+    __m256i v1 = loadSortValue(batch, 1, offset);
+    __m256i v2 = loadSortValue(batch, 2, offset);
+
+    // 三元素排序网络：(0,1) (1,2) (0,1)
+    __m256i t = _mm256_min_epi16(v0, v1); v1 = _mm256_max_epi16(v0, v1); v0 = t;
+    t = _mm256_min_epi16(v1, v2); v2 = _mm256_max_epi16(v1, v2); v1 = t;
+    t = _mm256_min_epi16(v0, v1); v1 = _mm256_max_epi16(v0, v1); v0 = t;
+
+    const __m256i three = _mm256_set1_epi16(3);
+    __m256i r0 = _mm256_srli_epi16(v0, 2), r1 = _mm256_srli_epi16(v1, 2), r2 = _mm256_srli_epi16(v2, 2);
+    __m256i q0 = _mm256_and_si256(v0, three), q1 = _mm256_and_si256(v1, three), q2 = _mm256_and_si256(v2, three);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16(1);
+
+    __m256i eq01 = _mm256_cmpeq_epi16(r0, r1);
+    __m256i eq12 = _mm256_cmpeq_epi16(r1, r2);
+    __m256i leopard = _mm256_and_si256(eq01, eq12);
+    __m256i flush = _mm256_and_si256(_mm256_cmpeq_epi16(q0, q1), _mm256_cmpeq_epi16(q1, q2));
+    __m256i low23 = _mm256_and_si256(_mm256_cmpeq_epi16(r0, zero), _mm256_cmpeq_epi16(r1, one));
+    __m256i straight = _mm256_or_si256(
+        _mm256_and_si256(low23, _mm256_cmpeq_epi16(r2, _mm256_set1_epi16(12))),   // A23
+        _mm256_and_si256(_mm256_cmpeq_epi16(_mm256_sub_epi16(r2, r1), one),
+                         _mm256_cmpeq_epi16(_mm256_sub_epi16(r1, r0), one)));
+    __m256i pair = _mm256_andnot_si256(leopard, _mm256_or_si256(eq01, eq12));
+    __m256i special235 = _mm256_and_si256(low23, _mm256_cmpeq_epi16(r2, three));
+
+    // 按evaluateHand的判定顺序，从低优先级到高优先级依次覆盖
+    __m256i type = _mm256_set1_epi16(static_cast<int>(CardType::HIGH_CARD));
+    type = select16(pair, _mm256_set1_epi16(static_cast<int>(CardType::PAIR)), type);
+    type = select16(special235, _mm256_set1_epi16(static_cast<int>(CardType::SPECIAL_235)), type);
+    type = select16(straight, _mm256_set1_epi16(static_cast<int>(CardType::STRAIGHT)), type);
+    type = select16(flush, _mm256_set1_epi16(static_cast<int>(CardType::FLUSH)), type);
+    type = select16(_mm256_and_si256(flush, straight), _mm256_set1_epi16(static_cast<int>(CardType::STRAIGHT_FLUSH)), type);
+    type = select16(leopard, _mm256_set1_epi16(static_cast<int>(CardType::THREE_OF_KIND)), type);
+
+    // 牌力键分量，默认按同花/单张：三张点数从大到小，再比最大牌花色
+    __m256i a = r2, b = r1, d = r0, suit = q2;
+    __m256i straightType = _mm256_or_si256(_mm256_cmpeq_epi16(type, _mm256_set1_epi16(static_cast<int>(CardType::STRAIGHT))),
+                                           _mm256_cmpeq_epi16(type, _mm256_set1_epi16(static_cast<int>(CardType::STRAIGHT_FLUSH))));
+    b = _mm256_andnot_si256(straightType, b);
+    d = _mm256_andnot_si256(straightType, d);
+
+    __m256i pairType = _mm256_cmpeq_epi16(type, _mm256_set1_epi16(static_cast<int>(CardType::PAIR)));
+    a = select16(pairType, select16(eq01, r0, r1), a);
+    b = select16(pairType, select16(eq01, r2, r0), b);
+    d = _mm256_andnot_si256(pairType, d);
+    suit = select16(pairType, select16(eq01, q0, q1), suit);
+
+    b = _mm256_andnot_si256(leopard, b);
+    d = _mm256_andnot_si256(leopard, d);
+    a = select16(leopard, r0, a);
+    suit = select16(leopard, q0, suit);
+
+    __m256i is235 = _mm256_cmpeq_epi16(type, _mm256_set1_epi16(static_cast<int>(CardType::SPECIAL_235)));
+    __m256i tier = _mm256_andnot_si256(is235, _mm256_add_epi16(type, one));
+    a = _mm256_andnot_si256(is235, a);
+    b = _mm256_andnot_si256(is235, b);
+    d = _mm256_andnot_si256(is235, d);
+    suit = _mm256_andnot_si256(is235, suit);
+
+    const __m256i thirteen = _mm256_set1_epi16(13);
+    __m256i key = _mm256_add_epi16(_mm256_mullo_epi16(tier, thirteen), a);
+    key = _mm256_add_epi16(_mm256_mullo_epi16(key, thirteen), b);
+    key = _mm256_add_epi16(_mm256_mullo_epi16(key, thirteen), d);
+    key = _mm256_add_epi16(_mm256_slli_epi16(key, 2), suit);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + offset), key);
+    static_assert(sizeof(CardType) == sizeof(int32_t), "CardType is stored as 32-bit lanes");
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(types + offset),
+                        _mm256_cvtepu16_epi32(_mm256_castsi256_si128(type)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(types + offset + 8),
+                        _mm256_cvtepu16_epi32(_mm256_extracti128_si256(type, 1)));
+}
+
+bool detectAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+} // namespace
+
+bool handBatchUsesAvx2() {
+    static const bool supported = detectAvx2();
+    return supported;
+}
+
+/**
+ * 批量评估手牌 - 整块16手走AVX2，剩余不足16手的尾部走逐手计算
+ * @param batch 结构数组形式的手牌
+ * @param types 输出牌型，长度不小于batch.count
+ * @param keys 输出牌力键，长度不小于batch.count
+ */
+void evaluateHandBatch(const HandBatch& batch, CardType* types, uint16_t* keys) {
+    if (!handBatchUsesAvx2()) {
+        evaluateHandBatchScalar(batch, types, keys);
+        return;
+    }
+
+    int offset = 0;
+    for (; offset + AVX2_LANES <= batch.count; offset += AVX2_LANES) {
+        evaluateBlockAvx2(batch, offset, types, keys);
+    }
+
+    HandBatch tail = batch;
+    for (int k = 0; k < 3; ++k) {
+        tail.ranks[k] += offset;
+        tail.suits[k] += offset;
+    }
+    tail.count = batch.count - offset;
+    evaluateHandBatchScalar(tail, types + offset, keys + offset);
+}
+
+#else
+
+bool handBatchUsesAvx2() {
+    return false;
+}
+
+void evaluateHandBatch(const HandBatch& batch, CardType* types, uint16_t* keys) {
+    evaluateHandBatchScalar(batch, types, keys);
+}
+
+#endif
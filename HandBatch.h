@@ -0,0 +1,28 @@
+//
+// Created for batch hand evaluation
+//
+
+#ifndef POKERSERVER_HANDBATCH_H
+#define POKERSERVER_HANDBATCH_H
+
+#include "HandStrength.h"
+#include <cstdint>
+
+// 一批手牌（结构数组）：第k张牌的点数和花色各自连续存放，便于按通道向量化
+struct HandBatch {
+    const uint8_t* ranks[3];  // 点数，取值2..14（Rank枚举值）
+    const uint8_t* suits[3];  // 花色，取值0..3（Suit枚举值）
+    int count;                // 手牌数
+};
+
+// 批量评估手牌：为每一手牌输出牌型和牌力键（见strengthKey，可用strengthKeyBeats比较）
+// 运行时检测CPU，支持AVX2时每条指令处理16手牌，否则退回逐手计算
+void evaluateHandBatch(const HandBatch& batch, CardType* types, uint16_t* keys);
+
+// 逐手计算的版本，与AVX2版本结果完全一致
+void evaluateHandBatchScalar(const HandBatch& batch, CardType* types, uint16_t* keys);
+
+// 当前CPU是否走AVX2路径
+bool handBatchUsesAvx2();
+
+#endif //POKERSERVER_HANDBATCH_H
@@ -0,0 +1,121 @@
+//
+// Created for suit-isomorphic hand classes
+// 编译期把每手牌的花色按点数掩码规范化，归入对应的同构类
+//
+
+#include "HandCanonical.h"
+#include <array>
+#include <cstdint>
+
+namespace {
+
+struct CanonicalTable {
+    std::array<uint16_t, HAND_COUNT> classOf;                  // 组合下标 -> 同构类
+    std::array<uint16_t, CANONICAL_CLASS_COUNT> representative; // 同构类 -> 代表组合下标
+    std::array<uint8_t, CANONICAL_CLASS_COUNT> size;            // 同构类 -> 手牌数
+    int classCount;
+};
+
+// 三张不同牌的组合下标（编译期版本，需先排序）
+constexpr int colexIndex(int a, int b, int c) {
+    if (a > b) { int t = a; a = b; b = t; }
+    if (b > c) { int t = b; b = c; c = t; }
+    if (a > b) { int t = a; a = b; b = t; }
+    return a + b * (b - 1) / 2 + c * (c - 1) * (c - 2) / 6;
+}
+
+/**
+ * 规范化一手牌 - 同构类只由各花色的点数集合构成的多重集决定，
+ * 把4个花色的点数掩码降序排列后依次改记为花色0..3，得到的手牌即为类代表
+ * @return 代表手牌的组合下标
+ */
+constexpr int canonicalIndex(int c0, int c1, int c2) {
+    int masks[4] = {0, 0, 0, 0};
+    masks[c0 % 4] |= 1 << (c0 / 4);
+    masks[c1 % 4] |= 1 << (c1 / 4);
+    masks[c2 % 4] |= 1 << (c2 / 4);
+
+    // 按点数掩码降序排列花色；掩码相同的花色互换后手牌不变，顺序无关紧要
+    int order[4] = {0, 1, 2, 3};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3 - i; ++j) {
+            if (masks[order[j]] < masks[order[j + 1]]) {
+                int t = order[j]; order[j] = order[j + 1]; order[j + 1] = t;
+            }
+        }
+    }
+    int newSuit[4] = {0, 0, 0, 0};
+    for (int k = 0; k < 4; ++k) {
+        newSuit[order[k]] = k;
+    }
+
+    return colexIndex(c0 / 4 * 4 + newSuit[c0 % 4],
+                      c1 / 4 * 4 + newSuit[c1 % 4],
+                      c2 / 4 * 4 + newSuit[c2 % 4]);
+}
+
+/**
+ * 生成同构类表 - 先求每手牌的代表下标，再把出现过的代表压缩为连续的类编号
+ */
+constexpr CanonicalTable buildCanonicalTable() {
+    CanonicalTable table{};
+    std::array<uint16_t, HAND_COUNT> canonical{};
+    std::array<int16_t, HAND_COUNT> classOfRepresentative{};
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        classOfRepresentative[i] = -1;
+    }
+
+    int index = 0;
+    for (int c2 = 2; c2 < 52; ++c2) {
+        for (int c1 = 1; c1 < c2; ++c1) {
+            for (int c0 = 0; c0 < c1; ++c0) {
+                canonical[index] = static_cast<uint16_t>(canonicalIndex(c0, c1, c2));
+                classOfRepresentative[canonical[index]] = 0;
+                ++index;
+            }
+        }
+    }
+
+    // 按代表下标递增编号
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        if (classOfRepresentative[i] == 0 && table.classCount < CANONICAL_CLASS_COUNT) {
+            table.representative[table.classCount] = static_cast<uint16_t>(i);
+            classOfRepresentative[i] = static_cast<int16_t>(table.classCount);
+            ++table.classCount;
+        } else if (classOfRepresentative[i] == 0) {
+            ++table.classCount;  // 类数超出预期，由static_assert报告
+        }
+    }
+
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        int cls = classOfRepresentative[canonical[i]];
+        table.classOf[i] = static_cast<uint16_t>(cls);
+        if (cls < CANONICAL_CLASS_COUNT) {
+            ++table.size[cls];
+        }
+    }
+    return table;
+}
+
+constexpr CanonicalTable CANONICAL_TABLE = buildCanonicalTable();
+
+static_assert(CANONICAL_TABLE.classCount == CANONICAL_CLASS_COUNT,
+              "unexpected number of suit-isomorphic classes");
+
+} // namespace
+
+int canonicalClass(int handIndex) {
+    return CANONICAL_TABLE.classOf[handIndex];
+}
+
+int canonicalClass(const Hand& hand) {
+    return CANONICAL_TABLE.classOf[handIndex(hand)];
+}
+
+int canonicalRepresentative(int canonicalClass) {
+    return CANONICAL_TABLE.representative[canonicalClass];
+}
+
+int canonicalClassSize(int canonicalClass) {
+    return CANONICAL_TABLE.size[canonicalClass];
+}
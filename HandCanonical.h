@@ -0,0 +1,26 @@
+//
+// Created for suit-isomorphic hand classes
+//
+
+#ifndef POKERSERVER_HANDCANONICAL_H
+#define POKERSERVER_HANDCANONICAL_H
+
+#include "HandIndex.h"
+
+// 花色同构类的总数：任意交换花色后相同的手牌归为一类
+const int CANONICAL_CLASS_COUNT = 1755;
+
+// 同构类只保留同花判断所需的信息，忽略红桃 > 黑桃 > 方块 > 梅花的花色比较，
+// 适合做胜率缓存的键；比牌需要花色比较，应使用handIndex/handStrength这套精确下标
+
+// 组合下标 -> 同构类，范围[0, CANONICAL_CLASS_COUNT)
+int canonicalClass(int handIndex);
+int canonicalClass(const Hand& hand);
+
+// 同构类的代表手牌（花色规范化后的一手）的组合下标
+int canonicalRepresentative(int canonicalClass);
+
+// 同构类包含的原始手牌数，用于按类汇总时加权
+int canonicalClassSize(int canonicalClass);
+
+#endif //POKERSERVER_HANDCANONICAL_H
@@ -0,0 +1,76 @@
+//
+// Created for three-card hand indexing
+// 组合数系统：下标 = C(c0,1) + C(c1,2) + C(c2,3)，其中c0 < c1 < c2
+//
+
+#include "HandIndex.h"
+#include "BitOps.h"
+#include <array>
+
+namespace {
+
+// 组合数表：BINOMIAL[k][n] = C(n, k)，k取1..3
+struct BinomialTable {
+    int value[4][52];
+};
+
+constexpr BinomialTable buildBinomialTable() {
+    BinomialTable table{};
+    for (int n = 0; n < 52; ++n) {
+        table.value[0][n] = 1;
+        table.value[1][n] = n;
+        table.value[2][n] = n * (n - 1) / 2;
+        table.value[3][n] = n * (n - 1) * (n - 2) / 6;
+    }
+    return table;
+}
+
+constexpr BinomialTable BINOMIAL = buildBinomialTable();
+
+// 反查表：组合下标 -> 一手牌
+constexpr std::array<Hand, HAND_COUNT> buildHandTable() {
+    std::array<Hand, HAND_COUNT> table{};
+    int index = 0;
+    for (int c2 = 2; c2 < 52; ++c2) {
+        for (int c1 = 1; c1 < c2; ++c1) {
+            for (int c0 = 0; c0 < c1; ++c0) {
+                table[index][0] = Card::fromIndex(c0);
+                table[index][1] = Card::fromIndex(c1);
+                table[index][2] = Card::fromIndex(c2);
+                ++index;
+            }
+        }
+    }
+    return table;
+}
+
+constexpr std::array<Hand, HAND_COUNT> HAND_TABLE = buildHandTable();
+
+} // namespace
+
+/**
+ * 计算一手牌的组合下标
+ * 每张牌在三张牌中的名次等于掩码中比它小的牌数，直接作为组合数的k-1，
+ * 因此无需排序：下标 = Σ C(c, 名次+1)
+ * @param hand 三张互不相同的牌，顺序任意
+ * @return 组合下标，范围[0, HAND_COUNT)
+ */
+int handIndex(const Hand& hand) {
+    uint64_t mask = handMask(hand);
+    int index = 0;
+    for (const Card& card : hand) {
+        int c = card.index();
+        int order = popcount64(mask & ((1ULL << c) - 1));  // 比该牌小的牌数：0、1或2
+        index += BINOMIAL.value[order + 1][c];
+    }
+    return index;
+}
+
+/**
+ * 由组合下标反查一手牌
+ * @param index 组合下标，范围[0, HAND_COUNT)
+ * @return 三张牌按下标从小到大排列的一手牌
+ */
+const Hand& handFromIndex(int index) {
+    return HAND_TABLE[index];
+}
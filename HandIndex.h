@@ -0,0 +1,26 @@
+//
+// Created for three-card hand indexing
+//
+
+#ifndef POKERSERVER_HANDINDEX_H
+#define POKERSERVER_HANDINDEX_H
+
+#include "Card.h"
+#include <cstdint>
+
+// 三张牌的组合总数 C(52,3)
+const int HAND_COUNT = 22100;
+
+// 一手牌的位掩码：第index()位表示该牌
+inline uint64_t handMask(const Hand& hand) {
+    return (1ULL << hand[0].index()) | (1ULL << hand[1].index()) | (1ULL << hand[2].index());
+}
+
+// 无序三张牌 -> 组合数系统(colex)下标，范围[0, HAND_COUNT)
+// 三张牌必须互不相同（牌靴发出的重复牌请用strengthKey）；与牌的顺序无关，不排序也不按牌序分支
+int handIndex(const Hand& hand);
+
+// 组合下标 -> 一手牌（三张牌按下标从小到大排列）
+const Hand& handFromIndex(int index);
+
+#endif //POKERSERVER_HANDINDEX_H
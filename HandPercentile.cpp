@@ -0,0 +1,146 @@
+//
+// Created for hand percentile lookup
+// 表文件由PercentileGenerator离线生成，这里只负责映射和校验，不做任何计算
+//
+
+#include "HandPercentile.h"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char PERCENTILE_MAGIC[8] = {'G', 'F', 'P', 'C', 'T', 'L', 0, 0};
+const uint32_t PERCENTILE_VERSION = 1;
+const uint32_t PERCENTILE_BYTE_ORDER = 0x01020304u;
+
+size_t expectedFileSize() {
+    return sizeof(PercentileTableHeader) + sizeof(float) * HAND_COUNT * PERCENTILE_ROW_WIDTH;
+}
+
+} // namespace
+
+/**
+ * 映射表文件
+ * 文件大小、魔数、版本、字节序和行宽任一不符都拒绝加载，防止读到过期或损坏的表
+ * @param path 表文件路径
+ */
+PercentileTable::PercentileTable(const string& path)
+    : header(nullptr), rows(nullptr), mapping(nullptr), mappingSize(0),
+      fileHandle(nullptr), mappingHandle(nullptr) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw runtime_error("Cannot open percentile table: " + path);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw runtime_error("Cannot read percentile table size: " + path);
+    }
+    mappingSize = static_cast<size_t>(size.QuadPart);
+    HANDLE map = mappingSize > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    const void* view = map ? MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (map) {
+            CloseHandle(map);
+        }
+        CloseHandle(file);
+        throw runtime_error("Cannot map percentile table: " + path);
+    }
+    fileHandle = file;
+    mappingHandle = map;
+    mapping = view;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Cannot open percentile table: " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw runtime_error("Cannot read percentile table size: " + path);
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    void* view = mappingSize > 0 ? mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);  // 映射建立后即可关闭文件描述符
+    if (view == MAP_FAILED) {
+        throw runtime_error("Cannot map percentile table: " + path);
+    }
+    mapping = view;
+#endif
+
+    header = static_cast<const PercentileTableHeader*>(mapping);
+    bool valid = mappingSize == expectedFileSize() &&
+                 memcmp(header->magic, PERCENTILE_MAGIC, sizeof(PERCENTILE_MAGIC)) == 0 &&
+                 header->version == PERCENTILE_VERSION &&
+                 header->byteOrder == PERCENTILE_BYTE_ORDER &&
+                 header->handCount == static_cast<uint32_t>(HAND_COUNT) &&
+                 header->rowWidth == static_cast<uint32_t>(PERCENTILE_ROW_WIDTH);
+    if (!valid) {
+        unmap();
+        throw invalid_argument("Invalid percentile table: " + path);
+    }
+    rows = reinterpret_cast<const float*>(header + 1);
+}
+
+PercentileTable::~PercentileTable() {
+    unmap();
+}
+
+void PercentileTable::unmap() {
+    if (!mapping) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapping);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+#else
+    munmap(const_cast<void*>(mapping), mappingSize);
+#endif
+    mapping = nullptr;
+}
+
+/**
+ * 写出表文件
+ * @param path 输出路径
+ * @param rows 按组合下标排列的HAND_COUNT行，每行PERCENTILE_ROW_WIDTH个值
+ * @param samples 生成多人列时每手牌的抽样次数，记录在文件头中
+ */
+void PercentileTable::write(const string& path, const vector<float>& rows, uint32_t samples) {
+    if (rows.size() != static_cast<size_t>(HAND_COUNT) * PERCENTILE_ROW_WIDTH) {
+        throw invalid_argument("Percentile table must have one row per hand.");
+    }
+
+    PercentileTableHeader header{};
+    memcpy(header.magic, PERCENTILE_MAGIC, sizeof(PERCENTILE_MAGIC));
+    header.version = PERCENTILE_VERSION;
+    header.byteOrder = PERCENTILE_BYTE_ORDER;
+    header.handCount = HAND_COUNT;
+    header.rowWidth = PERCENTILE_ROW_WIDTH;
+    header.samples = samples;
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        throw runtime_error("Cannot create percentile table: " + path);
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(rows.data(), sizeof(float), rows.size(), file) == rows.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        throw runtime_error("Cannot write percentile table: " + path);
+    }
+}
@@ -0,0 +1,68 @@
+//
+// Created for hand percentile lookup
+//
+
+#ifndef POKERSERVER_HANDPERCENTILE_H
+#define POKERSERVER_HANDPERCENTILE_H
+
+#include "Card.h"
+#include "HandIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// 表中对手数的上限：一手牌之外剩49张，最多再发16手
+const int PERCENTILE_MAX_OPPONENTS = 16;
+// 每手牌一行：第0列为百分位，第1..16列为同时赢下1..16名随机对手的概率
+const int PERCENTILE_ROW_WIDTH = PERCENTILE_MAX_OPPONENTS + 1;
+// 默认的表文件名
+const char* const PERCENTILE_TABLE_FILE = "hand_percentile.bin";
+
+// 表文件头，其后紧跟HAND_COUNT行float
+struct PercentileTableHeader {
+    char magic[8];           // "GFPCTL\0\0"
+    uint32_t version;
+    uint32_t byteOrder;      // 写入端的0x01020304，用于拒绝字节序不同的文件
+    uint32_t handCount;
+    uint32_t rowWidth;
+    uint32_t samples;        // 生成第2..16列时每手牌的抽样次数
+    uint32_t reserved;
+};
+
+// 只读的手牌百分位表：离线生成，运行时整块内存映射，查询为一次数组访问
+class PercentileTable {
+public:
+    explicit PercentileTable(const string& path = PERCENTILE_TABLE_FILE); // 映射并校验表文件
+    ~PercentileTable();
+
+    PercentileTable(const PercentileTable&) = delete;
+    PercentileTable& operator=(const PercentileTable&) = delete;
+
+    // 对一名随机对手的百分位：赢的比例加平局比例的一半，范围[0, 1]
+    float percentile(int handIndex) const { return rows[handIndex * PERCENTILE_ROW_WIDTH]; }
+    float percentile(const Hand& hand) const { return percentile(handIndex(hand)); }
+
+    // 同时赢下opponents名随机对手的概率，opponents取1..16
+    float beatAll(int handIndex, int opponents) const { return rows[handIndex * PERCENTILE_ROW_WIDTH + opponents]; }
+    float beatAll(const Hand& hand, int opponents) const { return beatAll(handIndex(hand), opponents); }
+
+    uint32_t samples() const { return header->samples; }
+
+    // 生成工具使用：把按行排列的数据写成表文件
+    static void write(const string& path, const vector<float>& rows, uint32_t samples);
+
+private:
+    const PercentileTableHeader* header;
+    const float* rows;
+    const void* mapping;
+    size_t mappingSize;
+    void* fileHandle;     // 仅Windows使用
+    void* mappingHandle;  // 仅Windows使用
+
+    void unmap();
+};
+
+#endif //POKERSERVER_HANDPERCENTILE_H
@@ -0,0 +1,222 @@
+//
+// Created for hand strength lookup table
+// 编译期生成全部22100种三张牌组合的牌力表，比牌只需一次整数比较
+//
+
+#include "HandStrength.h"
+#include <array>
+#include <cstdint>
+
+namespace {
+
+// 编译期生成的牌力表
+struct StrengthTable {
+    std::array<uint16_t, HAND_COUNT> strength; // 按组合下标存放的牌力
+    std::array<uint8_t, HAND_COUNT> type;      // 按组合下标存放的牌型
+    std::array<int, 8> typeBase;               // 各牌型的最小牌力（按CardType下标），用于反查
+};
+
+constexpr int choose2(int n) { return n * (n - 1) / 2; }
+constexpr int choose3(int n) { return n * (n - 1) * (n - 2) / 6; }
+
+/**
+ * 计算一手牌的牌力键 - 与原compareHands的比较规则逐条对应
+ * 牌按Card::operator<排序：点数升序，同点数时花色大的（红桃）排在后面
+ * 花色值越小越大，因此键中的花色分量取 3 - 花色值
+ * @param c 三张牌的下标（点数-2）*4+花色
+ * @param type 输出牌型
+ * @return 牌力键，键越大牌越大；特殊235所有组合共用最小键
+ */
+constexpr int computeStrengthKey(const int c[3], int& type) {
+    int r[3] = {c[0] / 4, c[1] / 4, c[2] / 4};
+    int s[3] = {c[0] % 4, c[1] % 4, c[2] % 4};
+
+    // 三元素排序，与Card::operator<一致
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2 - i; ++j) {
+            bool greater = r[j] > r[j + 1] || (r[j] == r[j + 1] && s[j] < s[j + 1]);
+            if (greater) {
+                int tr = r[j]; r[j] = r[j + 1]; r[j + 1] = tr;
+                int ts = s[j]; s[j] = s[j + 1]; s[j + 1] = ts;
+            }
+        }
+    }
+
+    bool leopard = r[0] == r[1] && r[1] == r[2];
+    bool flush = s[0] == s[1] && s[1] == s[2];
+    bool straight = (r[0] == 0 && r[1] == 1 && r[2] == 12) ||   // A23
+                    (r[2] - r[1] == 1 && r[1] - r[0] == 1);
+    bool pair = !leopard && (r[0] == r[1] || r[1] == r[2]);
+    bool special235 = r[0] == 0 && r[1] == 1 && r[2] == 3;
+
+    // 判定顺序与evaluateHand保持一致
+    if (leopard) type = static_cast<int>(CardType::THREE_OF_KIND);
+    else if (flush && straight) type = static_cast<int>(CardType::STRAIGHT_FLUSH);
+    else if (flush) type = static_cast<int>(CardType::FLUSH);
+    else if (straight) type = static_cast<int>(CardType::STRAIGHT);
+    else if (pair) type = static_cast<int>(CardType::PAIR);
+    else if (special235) type = static_cast<int>(CardType::SPECIAL_235);
+    else type = static_cast<int>(CardType::HIGH_CARD);
+
+    int tier = 0, a = 0, b = 0, d = 0, suit = 0;
+    switch (static_cast<CardType>(type)) {
+        case CardType::SPECIAL_235:
+            break;  // 235输给除豹子外的所有牌型，且互相之间不分大小
+        case CardType::THREE_OF_KIND:
+            a = r[0];
+            suit = 3 - s[0];
+            break;
+        case CardType::STRAIGHT_FLUSH:
+        case CardType::STRAIGHT:
+            a = r[2];
+            suit = 3 - s[2];
+            break;
+        case CardType::PAIR:
+            // 对子取排序后相邻相等的第一张，单牌为另一张
+            a = (r[0] == r[1]) ? r[0] : r[1];
+            b = (r[0] == r[1]) ? r[2] : r[0];
+            suit = 3 - ((r[0] == r[1]) ? s[0] : s[1]);
+            break;
+        default:  // 同花和单张逐张比较点数，再比最大牌花色
+            a = r[2];
+            b = r[1];
+            d = r[0];
+            suit = 3 - s[2];
+            break;
+    }
+    if (type != static_cast<int>(CardType::SPECIAL_235)) {
+        tier = type + 1;
+    }
+    return (((tier * 13 + a) * 13 + b) * 13 + d) * 4 + suit;
+}
+
+/**
+ * 生成牌力表 - 先标记所有出现过的牌力键，再用前缀和压缩为连续的牌力值
+ */
+constexpr StrengthTable buildStrengthTable() {
+    StrengthTable table{};
+    std::array<uint16_t, STRENGTH_KEY_SPACE> denseKey{};
+
+    // 第一遍：标记出现过的键
+    for (int c2 = 2; c2 < 52; ++c2) {
+        for (int c1 = 1; c1 < c2; ++c1) {
+            for (int c0 = 0; c0 < c1; ++c0) {
+                int cards[3] = {c0, c1, c2};
+                int type = 0;
+                denseKey[computeStrengthKey(cards, type)] = 1;
+            }
+        }
+    }
+
+    // 前缀和：键 -> 连续牌力
+    int next = 0;
+    for (int key = 0; key < STRENGTH_KEY_SPACE; ++key) {
+        int used = denseKey[key];
+        denseKey[key] = static_cast<uint16_t>(next);
+        next += used;
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        table.typeBase[i] = next;
+    }
+
+    // 第二遍：按组合下标写入牌力和牌型
+    for (int c2 = 2; c2 < 52; ++c2) {
+        for (int c1 = 1; c1 < c2; ++c1) {
+            for (int c0 = 0; c0 < c1; ++c0) {
+                int cards[3] = {c0, c1, c2};
+                int type = 0;
+                int strength = denseKey[computeStrengthKey(cards, type)];
+                int index = c0 + choose2(c1) + choose3(c2);
+                table.strength[index] = static_cast<uint16_t>(strength);
+                table.type[index] = static_cast<uint8_t>(type);
+                if (strength < table.typeBase[type]) {
+                    table.typeBase[type] = strength;
+                }
+            }
+        }
+    }
+    return table;
+}
+
+constexpr StrengthTable STRENGTH_TABLE = buildStrengthTable();
+
+// 编译期校验：235的牌力为0，豹子位于最顶端
+static_assert(STRENGTH_TABLE.typeBase[static_cast<int>(CardType::SPECIAL_235)] == 0,
+              "special 235 must be the weakest strength");
+static_assert(STRENGTH_TABLE.typeBase[static_cast<int>(CardType::THREE_OF_KIND)] >
+              STRENGTH_TABLE.typeBase[static_cast<int>(CardType::STRAIGHT_FLUSH)],
+              "leopard must be the strongest type");
+
+} // namespace
+
+int handStrength(int handIndex) {
+    return STRENGTH_TABLE.strength[handIndex];
+}
+
+int handStrength(const Hand& hand) {
+    return STRENGTH_TABLE.strength[handIndex(hand)];
+}
+
+CardType handType(int handIndex) {
+    return static_cast<CardType>(STRENGTH_TABLE.type[handIndex]);
+}
+
+CardType handType(const Hand& hand) {
+    return static_cast<CardType>(STRENGTH_TABLE.type[handIndex(hand)]);
+}
+
+// 由牌力反查牌型：特殊235固定为0，其余牌型按牌力区间从高到低查找
+CardType strengthType(int strength) {
+    if (strength == 0) {
+        return CardType::SPECIAL_235;
+    }
+    for (int type = static_cast<int>(CardType::THREE_OF_KIND); type > 0; --type) {
+        if (strength >= STRENGTH_TABLE.typeBase[type]) {
+            return static_cast<CardType>(type);
+        }
+    }
+    return CardType::HIGH_CARD;
+}
+
+bool isLeopardStrength(int strength) {
+    return strength >= STRENGTH_TABLE.typeBase[static_cast<int>(CardType::THREE_OF_KIND)];
+}
+
+bool isSpecial235Strength(int strength) {
+    return strength == 0;
+}
+
+/**
+ * 比较两手牌的牌力
+ * 特殊规则：235反杀豹子；其余情况牌力大者胜，相等视为不大于
+ * @return true表示strength1大于strength2
+ */
+bool strengthBeats(int strength1, int strength2) {
+    if (isSpecial235Strength(strength1) && isLeopardStrength(strength2)) {
+        return true;   // 235反杀豹子
+    }
+    if (isSpecial235Strength(strength2) && isLeopardStrength(strength1)) {
+        return false;  // 豹子被235反杀
+    }
+    return strength1 > strength2;
+}
+
+int strengthKey(const Hand& hand, CardType& type) {
+    int cards[3] = {hand[0].index(), hand[1].index(), hand[2].index()};
+    int typeValue = 0;
+    int key = computeStrengthKey(cards, typeValue);
+    type = static_cast<CardType>(typeValue);
+    return key;
+}
+
+// 牌力键的比较规则与strengthBeats相同
+bool strengthKeyBeats(int key1, int key2) {
+    if (key1 == 0 && key2 >= STRENGTH_KEY_LEOPARD_BASE) {
+        return true;   // 235反杀豹子
+    }
+    if (key2 == 0 && key1 >= STRENGTH_KEY_LEOPARD_BASE) {
+        return false;  // 豹子被235反杀
+    }
+    return key1 > key2;
+}
@@ -0,0 +1,51 @@
+//
+// Created for hand strength lookup table
+//
+
+#ifndef POKERSERVER_HANDSTRENGTH_H
+#define POKERSERVER_HANDSTRENGTH_H
+
+#include "Card.h"
+#include "HandIndex.h"
+
+// 牌型枚举
+enum class CardType {
+    HIGH_CARD,      // 单张
+    PAIR,           // 对子
+    STRAIGHT,       // 顺子
+    FLUSH,          // 同花
+    STRAIGHT_FLUSH, // 同花顺
+    THREE_OF_KIND,  // 豹子
+    SPECIAL_235     // 特殊235
+};
+// 牌型的种数
+const int CARD_TYPE_COUNT = 7;
+
+// 查表获取牌力：牌力越大牌越大，特殊235固定为0（按组合下标或按手牌）
+int handStrength(int handIndex);
+int handStrength(const Hand& hand);
+// 查表获取牌型
+CardType handType(int handIndex);
+CardType handType(const Hand& hand);
+
+// 由牌力反查牌型
+CardType strengthType(int strength);
+// 牌力是否为豹子
+bool isLeopardStrength(int strength);
+// 牌力是否为特殊235
+bool isSpecial235Strength(int strength);
+
+// 比较两手牌的牌力：true表示strength1大于strength2（已处理235反杀豹子）
+bool strengthBeats(int strength1, int strength2);
+
+// 牌力键：档位、三个点数和花色拼成的整数，与牌力同序（牌力即键的连续压缩）
+// 特殊235的键为0，豹子的键不小于STRENGTH_KEY_LEOPARD_BASE，最大不超过STRENGTH_KEY_SPACE
+const int STRENGTH_KEY_SPACE = 7 * 13 * 13 * 13 * 4;
+const int STRENGTH_KEY_LEOPARD_BASE = 6 * 13 * 13 * 13 * 4;
+
+// 直接计算一手牌的牌力键和牌型（不查表，允许重复的牌）
+int strengthKey(const Hand& hand, CardType& type);
+// 比较两个牌力键：true表示key1大于key2（已处理235反杀豹子）
+bool strengthKeyBeats(int key1, int key2);
+
+#endif //POKERSERVER_HANDSTRENGTH_H
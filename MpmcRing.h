@@ -0,0 +1,115 @@
+//
+// Created for lock-free bounded queue
+//
+
+#ifndef POKERSERVER_MPMCRING_H
+#define POKERSERVER_MPMCRING_H
+
+#include "ThreadPool.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+using namespace std;
+
+// 有界多生产者多消费者无锁环形队列（Vyukov算法）
+// 每个槽位带一个序号：序号等于入队位置时可写，等于入队位置+1时可读，
+// 生产者和消费者只在各自的位置计数器上做一次CAS，不使用锁
+template <typename T>
+class MpmcRing {
+public:
+    explicit MpmcRing(size_t capacity); // 容量必须是2的幂
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    bool tryPush(const T& value); // 队列满时返回false
+    bool tryPop(T& value);        // 队列空时返回false
+
+    size_t capacity() const { return mask + 1; }
+    // 近似的元素个数：并发修改时只作参考
+    size_t approximateSize() const;
+
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        T value;
+    };
+
+    unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(CACHE_LINE_SIZE) atomic<size_t> enqueuePos;  // 生产者和消费者的计数器放在不同缓存行
+    alignas(CACHE_LINE_SIZE) atomic<size_t> dequeuePos;
+
+    static size_t checkCapacity(size_t capacity);
+};
+
+template <typename T>
+size_t MpmcRing<T>::checkCapacity(size_t capacity) {
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+        throw invalid_argument("Ring capacity must be a power of two.");
+    }
+    return capacity;
+}
+
+template <typename T>
+MpmcRing<T>::MpmcRing(size_t capacity) : cells(new Cell[checkCapacity(capacity)]), mask(capacity - 1) {
+    for (size_t i = 0; i < capacity; ++i) {
+        cells[i].sequence.store(i, memory_order_relaxed);
+    }
+    enqueuePos.store(0, memory_order_relaxed);
+    dequeuePos.store(0, memory_order_relaxed);
+}
+
+template <typename T>
+bool MpmcRing<T>::tryPush(const T& value) {
+    size_t pos = enqueuePos.load(memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[pos & mask];
+        size_t sequence = cell.sequence.load(memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                cell.value = value;
+                cell.sequence.store(pos + 1, memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // 槽位还没被消费：队列已满
+        } else {
+            pos = enqueuePos.load(memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+bool MpmcRing<T>::tryPop(T& value) {
+    size_t pos = dequeuePos.load(memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[pos & mask];
+        size_t sequence = cell.sequence.load(memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                value = cell.value;
+                cell.sequence.store(pos + mask + 1, memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // 槽位还没被写入：队列为空
+        } else {
+            pos = dequeuePos.load(memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+size_t MpmcRing<T>::approximateSize() const {
+    size_t enqueued = enqueuePos.load(memory_order_relaxed);
+    size_t dequeued = dequeuePos.load(memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+#endif //POKERSERVER_MPMCRING_H
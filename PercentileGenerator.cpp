@@ -0,0 +1,129 @@
+//
+// Created for offline percentile table generation
+// 用法：PercentileGenerator [输出文件] [每手牌抽样次数] [种子] [线程数]
+// 第0列和第1列（一名对手）精确枚举；第2..16列用蒙特卡洛估计：
+// 每次抽样一次性发出16名对手（恰好用掉剩余49张中的48张），前N名对手的结果即第N列的一个样本
+//
+
+#include "HandPercentile.h"
+#include "HandStrength.h"
+#include "ThreadPool.h"
+#include "Rng.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+
+namespace {
+
+const uint32_t DEFAULT_SAMPLES = 20000;
+
+/**
+ * 计算一手牌对应的一行
+ * @param hero 这手牌的组合下标
+ * @param masks 全部手牌的位掩码
+ * @param strengths 全部手牌的牌力
+ * @param samples 多人列的抽样次数
+ * @param rng 这手牌专用的随机流
+ * @param row 输出的一行
+ */
+void computeRow(int hero, const vector<uint64_t>& masks, const vector<int>& strengths,
+                uint32_t samples, CounterRng& rng, float* row) {
+    uint64_t heroMask = masks[hero];
+    int heroStrength = strengths[hero];
+    bool heroLeopard = isLeopardStrength(heroStrength);
+    bool hero235 = isSpecial235Strength(heroStrength);
+
+    // 一名对手：枚举剩余49张中的全部C(49,3)手牌
+    uint64_t wins = 0, ties = 0, total = 0;
+    for (int opp = 0; opp < HAND_COUNT; ++opp) {
+        if (masks[opp] & heroMask) {
+            continue;
+        }
+        ++total;
+        if (strengthBeats(heroStrength, strengths[opp])) {
+            ++wins;
+        } else if (!strengthBeats(strengths[opp], heroStrength)) {
+            ++ties;
+        }
+    }
+    row[0] = static_cast<float>((wins + 0.5 * ties) / total);
+    row[1] = static_cast<float>(static_cast<double>(wins) / total);
+
+    // 多名对手：比牌规则与rankShowdown一致，场上有豹子时235提升为最大
+    uint8_t cards[49];
+    int liveCount = 0;
+    for (int card = 0; card < 52; ++card) {
+        if ((heroMask >> card & 1) == 0) {
+            cards[liveCount++] = static_cast<uint8_t>(card);
+        }
+    }
+    uint32_t beatAll[PERCENTILE_ROW_WIDTH] = {};
+    for (uint32_t sample = 0; sample < samples; ++sample) {
+        for (int i = 0; i < 3 * PERCENTILE_MAX_OPPONENTS; ++i) {
+            int j = i + static_cast<int>(uniformBelow(rng, static_cast<uint32_t>(liveCount - i)));
+            uint8_t t = cards[i]; cards[i] = cards[j]; cards[j] = t;
+        }
+        int maxOpponent = -1;
+        bool opponentLeopard = false;
+        bool opponent235 = false;
+        for (int n = 1; n <= PERCENTILE_MAX_OPPONENTS; ++n) {
+            const uint8_t* c = cards + 3 * (n - 1);
+            Hand hand = {Card::fromIndex(c[0]), Card::fromIndex(c[1]), Card::fromIndex(c[2])};
+            int strength = handStrength(hand);
+            maxOpponent = max(maxOpponent, strength);
+            opponentLeopard |= isLeopardStrength(strength);
+            opponent235 |= isSpecial235Strength(strength);
+
+            bool win;
+            if (hero235) {
+                win = opponentLeopard && !opponent235;   // 只有反杀豹子才可能赢，且不能有别的235并列
+            } else {
+                win = heroStrength > maxOpponent && !(heroLeopard && opponent235);
+            }
+            if (win) {
+                ++beatAll[n];
+            } else if (!hero235 || opponent235) {
+                break;  // 已经输给前n名对手，更多对手也不可能全赢
+            }
+            // 235输给前n名对手后，后面的对手拿到豹子时仍可能反杀全场，继续发下去
+        }
+    }
+    for (int n = 2; n <= PERCENTILE_MAX_OPPONENTS; ++n) {
+        row[n] = samples > 0 ? static_cast<float>(static_cast<double>(beatAll[n]) / samples) : 0.0f;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    string path = argc > 1 ? argv[1] : PERCENTILE_TABLE_FILE;
+    uint32_t samples = argc > 2 ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : DEFAULT_SAMPLES;
+    uint64_t seed = argc > 3 ? strtoull(argv[3], nullptr, 10) : 0;
+    int threadCount = argc > 4 ? atoi(argv[4]) : 0;
+
+    vector<uint64_t> masks(HAND_COUNT);
+    vector<int> strengths(HAND_COUNT);
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        masks[i] = handMask(handFromIndex(i));
+        strengths[i] = handStrength(i);
+    }
+
+    vector<float> rows(static_cast<size_t>(HAND_COUNT) * PERCENTILE_ROW_WIDTH);
+    auto start = chrono::steady_clock::now();
+    try {
+        ThreadPool pool(threadCount);
+        // 每手牌使用以(种子, 组合下标)为键的随机流，结果与线程数无关
+        pool.parallelFor(HAND_COUNT, [&](int hero, int) {
+            CounterRng rng(seed, static_cast<uint64_t>(hero));
+            computeRow(hero, masks, strengths, samples, rng, &rows[static_cast<size_t>(hero) * PERCENTILE_ROW_WIDTH]);
+        });
+        PercentileTable::write(path, rows, samples);
+    } catch (const exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printf("Wrote %s: %d hands, %u samples per hand, %.1f s\n", path.c_str(), HAND_COUNT, samples, seconds);
+    return 0;
+}
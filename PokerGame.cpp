@@ -5,59 +5,157 @@
 #include <iostream>
 using namespace std; // 引入std命名空间
 
-// 构造函数：初始化牌堆并洗牌
-GameLogic::GameLogic() {
-    initializeDeck();
-    shuffleDeck();
+// 构造函数：从系统熵源读取牌桌种子，牌堆初始为完整的一副牌
+GameLogic::GameLogic(RngEngine engine) : GameLogic(engine, entropySeed(), engine == RngEngine::CHACHA20) {
 }
 
-// 初始化牌堆：生成标准的52张扑克牌
-void GameLogic::initializeDeck() {
-    vector<string> suits = {"Hearts", "Diamonds", "Clubs", "Spades"};
-    vector<string> ranks = {"2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K", "A"};
+GameLogic::GameLogic(RngEngine engine, uint64_t tableSeed) : GameLogic(engine, tableSeed, false) {
+}
 
-    for (const auto& suit : suits) {
-        for (const auto& rank : ranks) {
-            deck.push_back(rank + " of " + suit);
-        }
-    }
+GameLogic::GameLogic(RngEngine engine, uint64_t tableSeed, bool secureKeys)
+    : engine(engine), tableSeed(tableSeed), nextHand(0), lastSeed{tableSeed, 0}, lastKey(), pool(nullptr),
+      secureKeys(secureKeys), lastKeyed(false) {
 }
 
-// 洗牌：随机打乱牌堆
-void GameLogic::shuffleDeck() {
-    random_device rd; // 随机种子
-    mt19937 g(rd());  // 随机数生成器
-    shuffle(deck.begin(), deck.end(), g); // 打乱牌堆
+// 收回所有牌：新的一局从完整的牌堆发牌，回放也以完整的牌堆为起点
+void GameLogic::resetDeck() {
+    deck.reset();
+    shoe.reset();
+}
+
+// 发牌：从剩余的牌中随机给每个玩家发三张牌
+vector<Hand> GameLogic::dealCards(int numPlayers) {
+    // 人数不合法时抛出invalid_argument
+    if (shoe.decks() > 1) {
+        shoe.checkDeal(numPlayers);
+    } else {
+        deck.checkDeal(numPlayers);
+    }
+    vector<Hand> hands(numPlayers); // 每个玩家的手牌
+    dealCards(numPlayers, hands.data(), numPlayers);
+    return hands;
 }
 
-// 发牌：依次给每个玩家发牌，直到每个玩家手中有三张牌
-vector<vector<string>> GameLogic::dealCards(int numPlayers) {
-    const int cardsPerPlayer = 3; // 每个玩家发三张牌
-    const int maxPlayers = deck.size() / CARDS_PER_PLAYER; // 最大玩家数
+DealStatus GameLogic::dealCards(int numPlayers, array<Hand, MAX_DEAL_HANDS>& hands) {
+    return dealCards(numPlayers, hands.data(), static_cast<int>(hands.size()));
+}
 
-    // 异常检测：玩家人数是否合法
-    if (numPlayers <= 0) {
-        throw invalid_argument("Number of players must be a positive integer.");
+/**
+ * 不分配内存的发牌 - 模拟器的热路径
+ * 校验失败时不消耗牌局编号，牌堆和缓冲区保持不变
+ * @param numPlayers 玩家人数
+ * @param hands 调用方的缓冲区，第i名玩家的手牌写入hands[i]
+ * @param capacity 缓冲区能放下的手数
+ * @return 发牌结果
+ */
+DealStatus GameLogic::dealCards(int numPlayers, Hand* hands, int capacity) {
+    bool fromShoe = shoe.decks() > 1;
+    DealStatus status = fromShoe ? shoe.dealStatus(numPlayers) : deck.dealStatus(numPlayers);
+    if (status != DealStatus::OK) {
+        return status;
+    }
+    if (numPlayers > capacity) {
+        return DealStatus::BUFFER_TOO_SMALL;
     }
-    if (numPlayers > maxPlayers) {
-        throw invalid_argument("Too many players! Maximum players allowed is " + to_string(maxPlayers) + ".");
+    if (fromShoe) {
+        // 牌靴按张抽取，随机流同样由(牌桌种子, 牌局编号)确定；真钱牌桌改由(本局密钥, 牌局编号)确定
+        lastSeed = nextDealSeed();
+        lastKeyed = secureKeys;
+        lastKey = secureKeys ? DealKey::fromEntropy() : DealKey();
+        TableRng rng = secureKeys ? TableRng(lastKey.words, lastSeed.handNumber)
+                                  : TableRng(engine, lastSeed.tableSeed, lastSeed.handNumber);
+        HalfWords<TableRng> words(rng);
+        shoe.deal(numPlayers, hands, words);
+        return DealStatus::OK;
     }
+    // 现洗时只洗发牌会读到的前几个位置，结果与池中洗好的整副牌相同，回放也一致
+    ShuffledDeck shuffled;
+    if (pool) {
+        shuffled = pool->pop();
+    } else if (secureKeys) {
+        shuffled = ShuffledDeck::fromKey(DealKey::fromEntropy(), nextDealSeed(), deck.shuffleDepth(numPlayers));
+    } else {
+        shuffled = ShuffledDeck::fromSeed(engine, nextDealSeed(), deck.shuffleDepth(numPlayers));
+    }
+    deck.dealFrom(numPlayers, hands, shuffled);
+    lastSeed = shuffled.seed;
+    lastKey = shuffled.key;
+    lastKeyed = shuffled.keyed;
+    return DealStatus::OK;
+}
 
-    vector<vector<string>> hands(numPlayers); // 每个玩家的手牌
+/**
+ * 回放一局的发牌
+ * @param engine 牌桌使用的随机数引擎（使用预洗牌池时为池的引擎）
+ * @param seed 该局记录的种子
+ * @param numPlayers 玩家人数
+ * @return 与当时完全相同的各玩家手牌
+ */
+vector<Hand> GameLogic::replayDeal(RngEngine engine, const DealSeed& seed, int numPlayers) {
+    Deck deck;
+    vector<Hand> hands(min(max(numPlayers, 0), MAX_DEAL_HANDS));
+    deck.dealFrom(numPlayers, hands.data(), ShuffledDeck::fromSeed(engine, seed, deck.shuffleDepth(numPlayers)));
+    return hands;
+}
 
-    for (int card = 0; card < cardsPerPlayer; ++card) { // 每人发三张牌
-        for (int player = 0; player < numPlayers; ++player) {
-            hands[player].push_back(deck.back()); // 从牌堆末尾取牌
-            deck.pop_back(); // 移除已发的牌
-        }
+/**
+ * 回放牌靴一局的发牌
+ * @param engine 牌桌使用的随机数引擎
+ * @param seed 该局记录的种子
+ * @param numPlayers 玩家人数
+ * @param decks 牌靴的副数，为1时与单副牌的回放相同
+ * @return 与当时完全相同的各玩家手牌
+ */
+vector<Hand> GameLogic::replayDeal(RngEngine engine, const DealSeed& seed, int numPlayers, int decks) {
+    if (decks == 1) {
+        return replayDeal(engine, seed, numPlayers);
     }
+    Shoe shoe(decks);
+    shoe.checkDeal(numPlayers);
+    vector<Hand> hands(numPlayers);
+    TableRng rng(engine, seed.tableSeed, seed.handNumber);
+    HalfWords<TableRng> words(rng);
+    shoe.deal(numPlayers, hands.data(), words);
+    return hands;
+}
 
+/**
+ * 回放真钱牌桌一局的发牌
+ * @param key 该局记录的密钥
+ * @param seed 该局记录的种子，牌局编号为ChaCha20的流编号
+ * @param numPlayers 玩家人数
+ * @param decks 牌靴的副数
+ * @return 与当时完全相同的各玩家手牌
+ */
+vector<Hand> GameLogic::replayDeal(const DealKey& key, const DealSeed& seed, int numPlayers, int decks) {
+    if (decks == 1) {
+        Deck deck;
+        vector<Hand> hands(min(max(numPlayers, 0), MAX_DEAL_HANDS));
+        deck.dealFrom(numPlayers, hands.data(), ShuffledDeck::fromKey(key, seed, deck.shuffleDepth(numPlayers)));
+        return hands;
+    }
+    Shoe shoe(decks);
+    shoe.checkDeal(numPlayers);
+    vector<Hand> hands(numPlayers);
+    TableRng rng(key.words, seed.handNumber);
+    HalfWords<TableRng> words(rng);
+    shoe.deal(numPlayers, hands.data(), words);
     return hands;
 }
 
+// 设置牌靴的副数，新的牌靴是满的
+void GameLogic::useShoe(int decks) {
+    shoe = Shoe(decks);
+}
+
+// 设置预洗牌池：多个牌桌可以共用同一个池
+void GameLogic::useDeckPool(DeckPool* deckPool) {
+    pool = deckPool;
+}
+
 // 打印牌堆（用于调试）
 void GameLogic::printDeck() const {
-    for (const auto& card : deck) {
-        cout << card << endl;
+    for (const auto& card : shoe.decks() > 1 ? shoe.cards() : deck.cards()) {
+        cout << card.toString() << endl;
     }
 }
\ No newline at end of file
@@ -6,22 +6,61 @@
 #define POKERSERVER_POKERGAME_H
 #include <vector>
 #include <string>
+#include <array>
 #include <algorithm>
-#include <random>
+#include "Card.h"
+#include "Deck.h"
+#include "DeckPool.h"
+#include "Shoe.h"
 using namespace std;
 // 全局变量：每个玩家的手牌数
 const int CARDS_PER_PLAYER = 3;
 
 class GameLogic {
 public:
-    GameLogic();
-    void shuffleDeck(); // 洗牌
-    vector<vector<string>> dealCards(int numPlayers); // 发牌
+    // 选择随机数引擎，牌桌种子从系统熵源读取一次
+    // CHACHA20牌桌每局从系统熵源取一个新的256位密钥洗牌（见DealKey），单局密钥泄露不会暴露其他牌局
+    explicit GameLogic(RngEngine engine = RngEngine::XOSHIRO256);
+    // 固定牌桌种子，牌局编号从0开始；CHACHA20的密钥由种子扩展，只用于模拟和测试
+    GameLogic(RngEngine engine, uint64_t tableSeed);
+    // 收回所有牌，换成完整的一副牌（或满的牌靴），每局开始时调用
+    // 没有单独的洗牌：每次发牌都从剩余的牌中均匀抽取，牌序由(牌桌种子, 牌局编号)确定
+    void resetDeck();
+    vector<Hand> dealCards(int numPlayers); // 发牌，人数不合法时抛出invalid_argument
+    // 不分配内存的发牌：写入调用方的缓冲区，人数不合法时返回错误码而不抛异常
+    DealStatus dealCards(int numPlayers, array<Hand, MAX_DEAL_HANDS>& hands);
+    DealStatus dealCards(int numPlayers, Hand* hands, int capacity);
+    void useDeckPool(DeckPool* deckPool); // 设置后发牌从预洗牌池取牌，nullptr表示在本线程现洗
+    // 副数大于1时改从多副牌的牌靴发牌：人数可超过17，手牌可能有重复的牌（比牌用rankShowdownKeys）
+    // 牌靴不使用预洗牌池；副数为1时恢复单副牌。副数不合法时抛出invalid_argument
+    void useShoe(int decks);
+    int deckCount() const { return shoe.decks(); }
+    DealSeed lastDealSeed() const { return lastSeed; } // 上一次发牌所用的种子，应随牌局记录
+    bool lastDealKeyed() const { return lastKeyed; }   // 上一次发牌是否用熵源密钥洗牌（真钱牌桌）
+    DealKey lastDealKey() const { return lastKey; }    // 该局的密钥，与种子一起记录才能回放
+
+    // 回放：由引擎和种子重新生成一局开始时（整副牌）的发牌结果
+    static vector<Hand> replayDeal(RngEngine engine, const DealSeed& seed, int numPlayers);
+    // 牌靴的回放：还需要当时的副数
+    static vector<Hand> replayDeal(RngEngine engine, const DealSeed& seed, int numPlayers, int decks);
+    // 真钱牌桌的回放：还需要该局记录的密钥，decks为当时牌靴的副数
+    static vector<Hand> replayDeal(const DealKey& key, const DealSeed& seed, int numPlayers, int decks = 1);
     void printDeck() const; // 打印牌堆（用于调试）
 
 private:
-    vector<string> deck; // 牌堆
-    void initializeDeck(); // 初始化牌堆
+    Deck deck;          // 牌堆
+    Shoe shoe;          // 多副牌的牌靴，副数为1时不使用
+    RngEngine engine;   // 洗牌使用的随机数引擎
+    uint64_t tableSeed; // 牌桌种子
+    uint64_t nextHand;  // 下一局的牌局编号
+    DealSeed lastSeed;  // 上一次发牌所用的种子
+    DealKey lastKey;    // 上一次发牌所用的密钥，lastKeyed为false时全零
+    DeckPool* pool;     // 预洗牌池，不拥有
+    bool secureKeys;    // 每局是否从熵源取新的密钥（CHACHA20牌桌）
+    bool lastKeyed;
+
+    GameLogic(RngEngine engine, uint64_t tableSeed, bool secureKeys);
+    DealSeed nextDealSeed() { return DealSeed{tableSeed, nextHand++}; }
 };
 
 #endif //POKERSERVER_POKERGAME_H
@@ -0,0 +1,190 @@
+//
+// Created for pluggable shuffle RNG engines
+// 系统熵源只在构造TableRng时读取，生成随机数的过程中不做任何系统调用
+//
+
+#include "Rng.h"
+#include "EntropyPool.h"
+
+namespace {
+
+// PCG64的128位乘数 0x2360ED051FC65DA44385DF649FCCF645
+const uint64_t PCG_MULTIPLIER_HIGH = 0x2360ED051FC65DA4ULL;
+const uint64_t PCG_MULTIPLIER_LOW = 0x4385DF649FCCF645ULL;
+
+// 64×64 -> 128位乘法，拆成32位分量计算
+void multiply64(uint64_t a, uint64_t b, uint64_t& high, uint64_t& low) {
+    uint64_t a0 = a & 0xFFFFFFFFULL, a1 = a >> 32;
+    uint64_t b0 = b & 0xFFFFFFFFULL, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t middle = (p00 >> 32) + (p01 & 0xFFFFFFFFULL) + (p10 & 0xFFFFFFFFULL);
+    low = (middle << 32) | (p00 & 0xFFFFFFFFULL);
+    high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+}
+
+inline uint32_t rotl32(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+inline void quarterRound(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+    a += b; d ^= a; d = rotl32(d, 16);
+    c += d; b ^= c; b = rotl32(b, 12);
+    a += b; d ^= a; d = rotl32(d, 8);
+    c += d; b ^= c; b = rotl32(b, 7);
+}
+
+} // namespace
+
+// 流编号先经SplitMix64打散再并入种子，之后扩展为256位初始状态
+// 同一种子下不同流的起点互不相同（打散是双射），也不会出现全零状态
+Xoshiro256::Xoshiro256(uint64_t seed, uint64_t stream) {
+    uint64_t state = seed ^ splitMix64(stream);
+    for (auto& word : s) {
+        word = splitMix64(state);
+    }
+}
+
+/**
+ * PCG64播种 - 与参考实现pcg64_srandom_r相同的步骤
+ * @param seed 种子，经SplitMix64扩展为128位初始状态
+ * @param stream 流编号，决定128位增量，不同流的序列互不重叠
+ */
+Pcg64::Pcg64(uint64_t seed, uint64_t stream) {
+    uint64_t mixer = stream;
+    incHigh = splitMix64(mixer);
+    incLow = splitMix64(mixer);
+    // 增量 = (流编号 << 1) | 1
+    incHigh = (incHigh << 1) | (incLow >> 63);
+    incLow = (incLow << 1) | 1;
+
+    uint64_t initHigh = splitMix64(seed);
+    uint64_t initLow = splitMix64(seed);
+    stateHigh = 0;
+    stateLow = 0;
+    step();
+    stateLow += initLow;
+    stateHigh += initHigh + (stateLow < initLow ? 1 : 0);
+    step();
+}
+
+void Pcg64::step() {
+    uint64_t high, low;
+    multiply64(stateLow, PCG_MULTIPLIER_LOW, high, low);
+    high += stateLow * PCG_MULTIPLIER_HIGH + stateHigh * PCG_MULTIPLIER_LOW;
+    low += incLow;
+    high += incHigh + (low < incLow ? 1 : 0);
+    stateHigh = high;
+    stateLow = low;
+}
+
+/**
+ * 由64位种子扩展出256位密钥 - 密钥空间只有2^64，不能用于真钱牌桌
+ * @param seed 种子，经SplitMix64扩展为8个密钥字
+ * @param stream 流编号
+ */
+ChaCha20Rng ChaCha20Rng::fromInsecureSeed(uint64_t seed, uint64_t stream) {
+    array<uint32_t, 8> key;
+    for (int i = 0; i < 8; i += 2) {
+        uint64_t word = splitMix64(seed);
+        key[i] = static_cast<uint32_t>(word);
+        key[i + 1] = static_cast<uint32_t>(word >> 32);
+    }
+    return ChaCha20Rng(key, stream);
+}
+
+/**
+ * 以256位密钥初始化
+ * @param key 密钥，真钱牌桌应全部来自系统熵源
+ * @param stream 流编号，写入nonce位置
+ */
+ChaCha20Rng::ChaCha20Rng(const array<uint32_t, 8>& key, uint64_t stream) : block(), position(16) {
+    state[0] = 0x61707865u;  // "expand 32-byte k"
+    state[1] = 0x3320646Eu;
+    state[2] = 0x79622D32u;
+    state[3] = 0x6B206574u;
+    for (int i = 0; i < 8; ++i) {
+        state[4 + i] = key[i];
+    }
+    state[12] = 0;
+    state[13] = 0;
+    state[14] = static_cast<uint32_t>(stream);
+    state[15] = static_cast<uint32_t>(stream >> 32);
+}
+
+void ChaCha20Rng::block20(const uint32_t input[16], uint32_t output[16]) {
+    uint32_t x[16];
+    for (int i = 0; i < 16; ++i) {
+        x[i] = input[i];
+    }
+    for (int round = 0; round < 10; ++round) {
+        // 列轮
+        quarterRound(x[0], x[4], x[8], x[12]);
+        quarterRound(x[1], x[5], x[9], x[13]);
+        quarterRound(x[2], x[6], x[10], x[14]);
+        quarterRound(x[3], x[7], x[11], x[15]);
+        // 对角轮
+        quarterRound(x[0], x[5], x[10], x[15]);
+        quarterRound(x[1], x[6], x[11], x[12]);
+        quarterRound(x[2], x[7], x[8], x[13]);
+        quarterRound(x[3], x[4], x[9], x[14]);
+    }
+    for (int i = 0; i < 16; ++i) {
+        output[i] = x[i] + input[i];
+    }
+}
+
+void ChaCha20Rng::refill() {
+    block20(state, block);
+    // 64位分组计数器加1
+    if (++state[12] == 0) {
+        ++state[13];
+    }
+    position = 0;
+}
+
+/**
+ * 从系统熵源播种 - 只在创建牌桌时调用一次，熵取自本线程的EntropyPool缓冲
+ * ChaCha20使用完整的256位熵作为密钥，其他引擎使用64位种子
+ * @param engine 引擎类型
+ */
+TableRng::TableRng(RngEngine engine) : kind(engine), philox(0, 0) {
+    EntropyPool& pool = EntropyPool::local();
+    if (engine == RngEngine::CHACHA20) {
+        array<uint32_t, 8> key;
+        pool.read(key.data(), sizeof(key));
+        chacha = ChaCha20Rng(key, pool.next64());
+    } else if (engine == RngEngine::PCG64) {
+        uint64_t seed = pool.next64();
+        pcg = Pcg64(seed, pool.next64());
+    } else if (engine == RngEngine::PHILOX) {
+        philox = CounterRng(pool.next64(), 0);
+    } else {
+        xoshiro = Xoshiro256(pool.next64());
+    }
+}
+
+/**
+ * 以固定种子播种 - 只初始化选中的引擎
+ * @param engine 引擎类型
+ * @param seed 种子
+ * @param stream 流编号，例如牌局编号
+ */
+TableRng::TableRng(RngEngine engine, uint64_t seed, uint64_t stream) : kind(engine), philox(0, 0) {
+    if (engine == RngEngine::CHACHA20) {
+        chacha = ChaCha20Rng::fromInsecureSeed(seed, stream);
+    } else if (engine == RngEngine::PCG64) {
+        pcg = Pcg64(seed, stream);
+    } else if (engine == RngEngine::PHILOX) {
+        philox = CounterRng(seed, stream);
+    } else {
+        xoshiro = Xoshiro256(seed, stream);
+    }
+}
+
+TableRng::TableRng(const array<uint32_t, 8>& key, uint64_t stream)
+    : kind(RngEngine::CHACHA20), chacha(key, stream), philox(0, 0) {
+}
+
+uint64_t entropySeed() {
+    return EntropyPool::local().next64();
+}
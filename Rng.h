@@ -0,0 +1,196 @@
+//
+// Created for pluggable shuffle RNG engines
+//
+
+#ifndef POKERSERVER_RNG_H
+#define POKERSERVER_RNG_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include "CounterRng.h"
+
+using namespace std;
+
+// 可选的随机数引擎
+enum class RngEngine {
+    XOSHIRO256,  // xoshiro256**：最快，适合模拟和普通牌桌
+    PCG64,       // PCG XSL RR 128/64：统计质量好，状态可预测性低于xoshiro
+    CHACHA20,    // ChaCha20流密码：以熵源的256位密钥播种时密码学安全，用于真钱牌桌
+    PHILOX       // Philox4x32-10计数器随机数：(种子, 牌局)直接决定随机位，适合分布式模拟
+};
+
+// SplitMix64：把一个64位种子扩展为多个互不相关的字，用于初始化其他引擎
+inline uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// 从系统熵源读取一个64位种子（经EntropyPool缓冲，只应在创建牌桌等冷路径上使用）
+uint64_t entropySeed();
+
+// 以下引擎都满足UniformRandomBitGenerator，每次输出64位
+
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<uint64_t>::max(); }
+
+    explicit Xoshiro256(uint64_t seed = 0, uint64_t stream = 0);
+    explicit Xoshiro256(const array<uint64_t, 4>& state) : s(state) {}
+
+    result_type operator()() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+private:
+    array<uint64_t, 4> s;
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+class Pcg64 {
+public:
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<uint64_t>::max(); }
+
+    explicit Pcg64(uint64_t seed = 0, uint64_t stream = 0);
+
+    result_type operator()() {
+        step();
+        // XSL RR：高低64位异或，再按最高6位循环右移
+        uint64_t x = stateHigh ^ stateLow;
+        int rot = static_cast<int>(stateHigh >> 58);
+        return (x >> rot) | (x << ((64 - rot) & 63));
+    }
+
+private:
+    uint64_t stateHigh, stateLow;  // 128位状态
+    uint64_t incHigh, incLow;      // 128位增量，必须为奇数
+
+    void step(); // state = state * MULTIPLIER + inc（128位运算，不依赖编译器的128位整数）
+};
+
+class ChaCha20Rng {
+public:
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<uint64_t>::max(); }
+
+    ChaCha20Rng() : ChaCha20Rng(array<uint32_t, 8>{}, 0) {} // 全零密钥，只作占位，使用前要重新赋值
+    ChaCha20Rng(const array<uint32_t, 8>& key, uint64_t stream);
+    // 由64位种子扩展出密钥：只有64位熵，只用于模拟、测试和固定种子的回放，真钱牌桌必须用完整的256位密钥
+    static ChaCha20Rng fromInsecureSeed(uint64_t seed, uint64_t stream);
+
+    result_type operator()() {
+        if (position >= 16) {
+            refill();
+        }
+        uint64_t low = block[position];
+        uint64_t high = block[position + 1];
+        position += 2;
+        return low | (high << 32);
+    }
+
+    // ChaCha20分组函数（RFC 7539），input为16个字的初始状态
+    static void block20(const uint32_t input[16], uint32_t output[16]);
+
+private:
+    uint32_t state[16];  // 常量、256位密钥、64位分组计数器、64位流编号
+    uint32_t block[16];  // 当前分组的输出
+    int position;        // block中下一个未用的字
+
+    void refill();
+};
+
+// 牌桌随机数：构造时选择引擎并播种一次，之后每手牌复用，热路径上没有系统调用
+// 引擎全部内嵌在对象里，调用时按引擎类型分派，不需要虚函数和堆分配
+class TableRng {
+public:
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<uint64_t>::max(); }
+
+    explicit TableRng(RngEngine engine = RngEngine::XOSHIRO256); // 从系统熵源播种
+    // 固定种子和流编号，结果可复现；同一种子的不同流互不相关
+    // CHACHA20的密钥由种子扩展而来，只有64位熵，真钱牌桌用下面的完整密钥
+    TableRng(RngEngine engine, uint64_t seed, uint64_t stream = 0);
+    // CHACHA20，以256位密钥和流编号播种
+    TableRng(const array<uint32_t, 8>& key, uint64_t stream);
+
+    RngEngine engine() const { return kind; }
+
+    result_type operator()() {
+        switch (kind) {
+            case RngEngine::PCG64: return pcg();
+            case RngEngine::CHACHA20: return chacha();
+            case RngEngine::PHILOX: return philox.next64();
+            default: return xoshiro();
+        }
+    }
+
+private:
+    RngEngine kind;
+    Xoshiro256 xoshiro;
+    Pcg64 pcg;
+    ChaCha20Rng chacha;
+    CounterRng philox;
+};
+
+// [0, bound)内的均匀整数：Lemire乘法取高位，拒绝少量偏差区间；bound必须大于0
+// rng为任意输出至少32位的UniformRandomBitGenerator，只使用每次输出的低32位
+template <typename Rng>
+uint32_t uniformBelow(Rng& rng, uint32_t bound) {
+    static_assert(Rng::max() - Rng::min() >= numeric_limits<uint32_t>::max(),
+                  "RNG must produce at least 32 random bits");
+    uint64_t product = static_cast<uint64_t>(static_cast<uint32_t>(rng() - Rng::min())) * bound;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < bound) {
+        uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+        while (low < threshold) {
+            product = static_cast<uint64_t>(static_cast<uint32_t>(rng() - Rng::min())) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<uint32_t>(product >> 32);
+}
+
+// 把64位引擎的每次输出拆成两个32位字：uniformBelow只用32位，拆开后引擎调用次数减半
+template <typename Rng>
+class HalfWords {
+public:
+    using result_type = uint32_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<uint32_t>::max(); }
+
+    explicit HalfWords(Rng& rng) : source(rng), pending(0), hasPending(false) {}
+
+    result_type operator()() {
+        if (hasPending) {
+            hasPending = false;
+            return static_cast<uint32_t>(pending >> 32);
+        }
+        pending = source();
+        hasPending = true;
+        return static_cast<uint32_t>(pending);
+    }
+
+private:
+    Rng& source;
+    uint64_t pending;
+    bool hasPending;
+};
+
+#endif //POKERSERVER_RNG_H
@@ -0,0 +1,67 @@
+//
+// Created for multi-deck shoe
+//
+
+#include "Shoe.h"
+#include <string>
+
+namespace {
+
+// 每4位一个1：16个计数器各为1
+const uint64_t COUNTER_ONES = 0x1111111111111111ULL;
+
+} // namespace
+
+Shoe::Shoe(int decks) : counters(), deckCount(decks), remaining(0) {
+    if (decks < 1 || decks > MAX_SHOE_DECKS) {
+        throw invalid_argument("Shoe must hold between 1 and " + to_string(MAX_SHOE_DECKS) + " decks.");
+    }
+    reset();
+}
+
+/**
+ * 收回所有牌 - 每个计数器置为副数；最后一个整数只有52-48=4个计数器
+ */
+void Shoe::reset() {
+    uint64_t full = COUNTER_ONES * static_cast<uint64_t>(deckCount);
+    counters[0] = full;
+    counters[1] = full;
+    counters[2] = full;
+    counters[3] = full & ((1ULL << ((DECK_SIZE - 3 * COUNTERS_PER_WORD) * 4)) - 1);
+    remaining = DECK_SIZE * deckCount;
+}
+
+vector<Card> Shoe::cards() const {
+    vector<Card> result;
+    result.reserve(remaining);
+    for (int card = 0; card < DECK_SIZE; ++card) {
+        for (int copy = counter(card); copy > 0; --copy) {
+            result.push_back(Card::fromIndex(card));
+        }
+    }
+    return result;
+}
+
+DealStatus Shoe::dealStatus(int numHands) const {
+    if (numHands <= 0) {
+        return DealStatus::INVALID_PLAYER_COUNT;
+    }
+    if (numHands > remaining / 3) {
+        return DealStatus::NOT_ENOUGH_CARDS;
+    }
+    return DealStatus::OK;
+}
+
+/**
+ * 校验发牌人数
+ * @param numHands 要发的手数
+ */
+void Shoe::checkDeal(int numHands) const {
+    DealStatus status = dealStatus(numHands);
+    if (status == DealStatus::INVALID_PLAYER_COUNT) {
+        throw invalid_argument("Number of players must be a positive integer.");
+    }
+    if (status == DealStatus::NOT_ENOUGH_CARDS) {
+        throw invalid_argument("Too many players! Maximum players allowed is " + to_string(remaining / 3) + ".");
+    }
+}
@@ -0,0 +1,124 @@
+//
+// Created for multi-deck shoe
+//
+
+#ifndef POKERSERVER_SHOE_H
+#define POKERSERVER_SHOE_H
+
+#include "Deck.h"
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+// 牌靴最多的副数：每张牌的剩余张数用4位计数器表示
+const int MAX_SHOE_DECKS = 15;
+
+// 多副牌的牌靴：52个4位计数器打包在4个64位整数中，每个整数16张牌，不分配内存
+// 同一张牌可能被发出多次，手牌需用strengthKey/rankShowdownKeys评估，不能查22100手的牌力表
+// 发牌的开销只与发出的张数有关，与副数无关
+class Shoe {
+public:
+    explicit Shoe(int decks = 1); // 副数不在[1, MAX_SHOE_DECKS]内时抛出invalid_argument
+
+    void reset(); // 收回所有牌
+
+    int decks() const { return deckCount; }
+    int size() const { return remaining; }
+    int count(const Card& card) const { return counter(card.index()); } // 该牌的剩余张数
+
+    // 剩余的牌，按下标从小到大排列，重复的牌重复出现（用于调试输出）
+    vector<Card> cards() const;
+
+    // 检查能否发numHands手牌（人数只受剩余张数限制）
+    DealStatus dealStatus(int numHands) const;
+    // 同上，不能发时抛出invalid_argument
+    void checkDeal(int numHands) const;
+
+    // 随机发numHands手牌到hands，第k张牌发给第k%N名玩家；剩余的牌不够时抛出invalid_argument
+    template <typename Rng>
+    void deal(int numHands, Hand* hands, Rng& rng);
+
+    // 随机抽一张牌并从牌靴移除
+    template <typename Rng>
+    Card draw(Rng& rng);
+
+private:
+    static const int COUNTERS_PER_WORD = 16;
+
+    array<uint64_t, 4> counters;  // 第card张牌的计数器在counters[card/16]的第(card%16)*4位
+    int deckCount;
+    int remaining;                // 剩余总张数
+
+    int counter(int card) const {
+        return static_cast<int>(counters[card / COUNTERS_PER_WORD] >> (card % COUNTERS_PER_WORD * 4) & 0xF);
+    }
+    void take(int card) {
+        counters[card / COUNTERS_PER_WORD] -= 1ULL << (card % COUNTERS_PER_WORD * 4);
+        --remaining;
+    }
+
+    // 一个整数中16个计数器之和：先两两相加成8个字节，再用乘法把字节累加到最高字节
+    static int wordTotal(uint64_t word) {
+        uint64_t bytes = (word & 0x0F0F0F0F0F0F0F0FULL) + (word >> 4 & 0x0F0F0F0F0F0F0F0FULL);
+        return static_cast<int>(bytes * 0x0101010101010101ULL >> 56);
+    }
+
+    template <typename Rng>
+    int pick(Rng& rng) const;
+};
+
+/**
+ * 均匀选出一张剩余的牌（按剩余张数加权）
+ * 剩余不少于四分之一时拒绝采样：在52×副数个位置中均匀选一个，位置上的那张还在就接受，平均不超过4次
+ * 牌靴快空时改为累加查找：先按整数跳过，再在一个整数内逐个计数器查找
+ * @return 牌的下标
+ */
+template <typename Rng>
+int Shoe::pick(Rng& rng) const {
+    uint32_t slotCount = static_cast<uint32_t>(DECK_SIZE * deckCount);
+    if (static_cast<uint32_t>(remaining) * 4 >= slotCount) {
+        for (;;) {
+            uint32_t slot = uniformBelow(rng, slotCount);
+            int card = static_cast<int>(slot / deckCount);
+            if (static_cast<int>(slot % deckCount) < counter(card)) {
+                return card;
+            }
+        }
+    }
+    int target = static_cast<int>(uniformBelow(rng, static_cast<uint32_t>(remaining)));
+    int word = 0;
+    for (int total = wordTotal(counters[0]); target >= total; total = wordTotal(counters[++word])) {
+        target -= total;
+    }
+    int card = word * COUNTERS_PER_WORD;
+    for (; target >= counter(card); ++card) {
+        target -= counter(card);
+    }
+    return card;
+}
+
+template <typename Rng>
+void Shoe::deal(int numHands, Hand* hands, Rng& rng) {
+    checkDeal(numHands);
+    int needed = 3 * numHands;
+    for (int i = 0; i < needed; ++i) {
+        int card = pick(rng);
+        take(card);
+        hands[i % numHands][i / numHands] = Card::fromIndex(card);
+    }
+}
+
+template <typename Rng>
+Card Shoe::draw(Rng& rng) {
+    if (remaining == 0) {
+        throw invalid_argument("Shoe is empty.");
+    }
+    int card = pick(rng);
+    take(card);
+    return Card::fromIndex(card);
+}
+
+#endif //POKERSERVER_SHOE_H
@@ -0,0 +1,122 @@
+//
+// Created for multi-way showdown ranking
+//
+
+#include "Showdown.h"
+
+namespace {
+
+// 场上有豹子时235的等效牌力：高于任何真实牌力和牌力键
+const int PROMOTED_235 = 1 << 16;
+static_assert(PROMOTED_235 > STRENGTH_KEY_SPACE, "promoted 235 must beat every strength key");
+
+// 牌力表最多只有几千种取值，能放进栈上缓冲区的人数直接处理
+const int STACK_PLAYERS = 64;
+
+// keys为true时输入是牌力键：235的键为0，豹子的键不小于STRENGTH_KEY_LEOPARD_BASE
+void rankEffective(const int* strengths, int count, int* order, int* place, int* effective, bool keys) {
+    // 第一遍：判断场上是否有豹子
+    bool hasLeopard = false;
+    for (int i = 0; i < count; ++i) {
+        hasLeopard |= keys ? strengths[i] >= STRENGTH_KEY_LEOPARD_BASE : isLeopardStrength(strengths[i]);
+    }
+
+    // 第二遍：算出等效牌力，并按等效牌力降序插入排序（人数很少，插入排序最快）
+    for (int i = 0; i < count; ++i) {
+        int value = strengths[i];
+        if (hasLeopard && (keys ? value == 0 : isSpecial235Strength(value))) {
+            value = PROMOTED_235;  // 235反杀豹子，而豹子大于其他所有牌
+        }
+        effective[i] = value;
+
+        int pos = i;
+        while (pos > 0 && effective[order[pos - 1]] < value) {
+            order[pos] = order[pos - 1];
+            --pos;
+        }
+        order[pos] = i;
+    }
+
+    // 名次：严格大于它的手牌数
+    for (int rank = 0; rank < count; ++rank) {
+        int seat = order[rank];
+        if (rank > 0 && effective[order[rank - 1]] == effective[seat]) {
+            place[seat] = place[order[rank - 1]];
+        } else {
+            place[seat] = rank;
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * 按牌力给多名玩家排名
+ * @param strengths 每个座位的牌力（handStrength的返回值）
+ * @param count 座位数
+ * @param order 输出：座位按名次从大到小排列
+ * @param place 输出：每个座位的名次，牌力相同名次相同
+ */
+void rankShowdownStrengths(const int* strengths, int count, int* order, int* place) {
+    int stackBuffer[STACK_PLAYERS] = {};
+    vector<int> heapBuffer;
+    int* effective = stackBuffer;
+    if (count > STACK_PLAYERS) {
+        heapBuffer.resize(count);
+        effective = heapBuffer.data();
+    }
+    rankEffective(strengths, count, order, place, effective, false);
+}
+
+/**
+ * 多人比牌 - 查表得到每手牌的牌力后一次排出全部名次
+ * @param hands 每个座位的手牌
+ * @param count 座位数
+ * @param order 输出：座位按名次从大到小排列
+ * @param place 输出：每个座位的名次，牌力相同名次相同
+ */
+void rankShowdown(const Hand* hands, int count, int* order, int* place) {
+    int stackBuffer[STACK_PLAYERS] = {};
+    vector<int> heapBuffer;
+    int* strengths = stackBuffer;
+    if (count > STACK_PLAYERS) {
+        heapBuffer.resize(count);
+        strengths = heapBuffer.data();
+    }
+    for (int i = 0; i < count; ++i) {
+        strengths[i] = handStrength(hands[i]);
+    }
+    rankShowdownStrengths(strengths, count, order, place);
+}
+
+/**
+ * 允许重复牌的多人比牌 - 直接计算牌力键，用于多副牌的牌靴
+ * 重复的牌只影响牌型判定（例如两张红桃A加红桃K算同花），比较规则和235反杀豹子不变
+ * @param hands 每个座位的手牌
+ * @param count 座位数
+ * @param order 输出：座位按名次从大到小排列
+ * @param place 输出：每个座位的名次，牌力键相同名次相同
+ */
+void rankShowdownKeys(const Hand* hands, int count, int* order, int* place) {
+    int stackBuffer[2 * STACK_PLAYERS] = {};
+    vector<int> heapBuffer;
+    int* keys = stackBuffer;
+    if (count > STACK_PLAYERS) {
+        heapBuffer.resize(2 * count);
+        keys = heapBuffer.data();
+    }
+    CardType type;
+    for (int i = 0; i < count; ++i) {
+        keys[i] = strengthKey(hands[i], type);
+    }
+    rankEffective(keys, count, order, place, keys + count, true);
+}
+
+ShowdownRanking rankShowdown(const vector<Hand>& hands) {
+    ShowdownRanking ranking;
+    int count = static_cast<int>(hands.size());
+    ranking.order.resize(count);
+    ranking.place.resize(count);
+    rankShowdown(hands.data(), count, ranking.order.data(), ranking.place.data());
+    return ranking;
+}
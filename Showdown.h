@@ -0,0 +1,32 @@
+//
+// Created for multi-way showdown ranking
+//
+
+#ifndef POKERSERVER_SHOWDOWN_H
+#define POKERSERVER_SHOWDOWN_H
+
+#include "HandStrength.h"
+#include <vector>
+
+using namespace std;
+
+// 多人比牌结果
+struct ShowdownRanking {
+    vector<int> order;  // 座位按名次从大到小排列，order[0]为最大的一手
+    vector<int> place;  // 每个座位的名次：严格大于它的手牌数，牌力相同名次相同
+};
+
+// 一次性给count手牌排出完整名次，结果写入调用方提供的order/place（长度不小于count），不分配内存
+// 235与豹子的循环：场上有豹子时，235反杀豹子，因而排在所有手牌之前；没有豹子时235垫底
+void rankShowdown(const Hand* hands, int count, int* order, int* place);
+
+// 同上，输入为已查好的牌力
+void rankShowdownStrengths(const int* strengths, int count, int* order, int* place);
+
+// 同上，但手牌中允许出现重复的牌（多副牌的牌靴），按牌力键比较
+void rankShowdownKeys(const Hand* hands, int count, int* order, int* place);
+
+// 便捷版本
+ShowdownRanking rankShowdown(const vector<Hand>& hands);
+
+#endif //POKERSERVER_SHOWDOWN_H
@@ -0,0 +1,161 @@
+//
+// Created for shuffle fairness validation
+// 用法：ShuffleFairness [洗牌次数] [引擎 xoshiro|pcg64|chacha20|philox] [牌桌种子] [线程数]
+// 走与发牌完全相同的ShuffledDeck::fromSeed路径，统计两类频数并做卡方检验：
+//   位置×牌：第p个位置出现第c张牌的次数，期望为N/52
+//   相邻牌对：牌a紧接在牌b之前的次数（a≠b），期望为N/52
+// 每个线程只写自己的计数矩阵，内层循环没有原子操作和共享缓存行，结束后再汇总
+//
+
+#include "Deck.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+
+namespace {
+
+const uint64_t DEFAULT_SHUFFLES = 100000000;
+// 每个线程领取的任务数：任务越细，线程之间负载越均衡
+const int TASKS_PER_THREAD = 16;
+
+// 每线程的计数矩阵，按缓存行对齐；单元格用32位计数，每线程最多可累计约2×10^11次洗牌
+struct alignas(CACHE_LINE_SIZE) FairnessCounters {
+    uint32_t position[DECK_SIZE][DECK_SIZE];   // [位置][牌]
+    uint32_t adjacent[DECK_SIZE][DECK_SIZE];   // [前一张牌][后一张牌]
+};
+
+// 卡方检验的结果
+struct ChiSquare {
+    double statistic;
+    int degrees;
+    double pValue;
+};
+
+/**
+ * 卡方上尾概率 - Wilson-Hilferty正态近似，自由度在几千时误差可以忽略
+ * @param statistic 卡方统计量
+ * @param degrees 自由度
+ * @return P(X >= statistic)
+ */
+double chiSquareTail(double statistic, int degrees) {
+    double k = static_cast<double>(degrees);
+    double z = (pow(statistic / k, 1.0 / 3.0) - (1.0 - 2.0 / (9.0 * k))) / sqrt(2.0 / (9.0 * k));
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+/**
+ * 对一个频数矩阵做卡方检验
+ * @param counts 汇总后的频数，按行排列
+ * @param skipDiagonal 是否跳过对角线（相邻牌对中同一张牌不可能相邻）
+ * @param expected 每个单元格的期望频数
+ * @param degrees 自由度
+ */
+ChiSquare testMatrix(const vector<uint64_t>& counts, bool skipDiagonal, double expected, int degrees) {
+    double statistic = 0.0;
+    for (int row = 0; row < DECK_SIZE; ++row) {
+        for (int col = 0; col < DECK_SIZE; ++col) {
+            if (skipDiagonal && row == col) {
+                continue;
+            }
+            double diff = static_cast<double>(counts[row * DECK_SIZE + col]) - expected;
+            statistic += diff * diff / expected;
+        }
+    }
+    return ChiSquare{statistic, degrees, chiSquareTail(statistic, degrees)};
+}
+
+bool parseEngine(const string& name, RngEngine& engine) {
+    if (name == "xoshiro") {
+        engine = RngEngine::XOSHIRO256;
+    } else if (name == "pcg64") {
+        engine = RngEngine::PCG64;
+    } else if (name == "chacha20") {
+        engine = RngEngine::CHACHA20;
+    } else if (name == "philox") {
+        engine = RngEngine::PHILOX;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void printResult(const char* name, const ChiSquare& result) {
+    printf("%-18s chi2 = %12.2f  df = %4d  p = %.4f\n", name, result.statistic, result.degrees, result.pValue);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t shuffles = argc > 1 ? strtoull(argv[1], nullptr, 10) : DEFAULT_SHUFFLES;
+    string engineName = argc > 2 ? argv[2] : "chacha20";
+    uint64_t tableSeed = argc > 3 ? strtoull(argv[3], nullptr, 10) : 0;
+    int threadCount = argc > 4 ? atoi(argv[4]) : 0;
+
+    RngEngine engine;
+    if (shuffles == 0 || !parseEngine(engineName, engine)) {
+        fprintf(stderr, "Usage: %s [shuffles] [xoshiro|pcg64|chacha20|philox] [seed] [threads]\n", argv[0]);
+        return 1;
+    }
+
+    vector<uint64_t> position(DECK_SIZE * DECK_SIZE, 0);
+    vector<uint64_t> adjacent(DECK_SIZE * DECK_SIZE, 0);
+    double seconds = 0.0;
+    int workers = 0;
+    try {
+        ThreadPool pool(threadCount);
+        workers = pool.size();
+        unique_ptr<FairnessCounters[]> counters(new FairnessCounters[workers]);
+        memset(counters.get(), 0, sizeof(FairnessCounters) * workers);
+
+        // 牌局编号按任务均分为连续的段，整数计数的汇总结果与线程数和调度无关
+        int tasks = workers * TASKS_PER_THREAD;
+        auto start = chrono::steady_clock::now();
+        pool.parallelFor(tasks, [&](int task, int worker) {
+            FairnessCounters& local = counters[worker];
+            uint64_t begin = shuffles / tasks * task + min<uint64_t>(task, shuffles % tasks);
+            uint64_t end = begin + shuffles / tasks + (static_cast<uint64_t>(task) < shuffles % tasks ? 1 : 0);
+            for (uint64_t hand = begin; hand < end; ++hand) {
+                ShuffledDeck deck = ShuffledDeck::fromSeed(engine, DealSeed{tableSeed, hand});
+                const uint8_t* order = deck.order.data();
+                for (int pos = 0; pos < DECK_SIZE; ++pos) {
+                    ++local.position[pos][order[pos]];
+                }
+                for (int pos = 0; pos + 1 < DECK_SIZE; ++pos) {
+                    ++local.adjacent[order[pos]][order[pos + 1]];
+                }
+            }
+        });
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        for (int w = 0; w < workers; ++w) {
+            for (int row = 0; row < DECK_SIZE; ++row) {
+                for (int col = 0; col < DECK_SIZE; ++col) {
+                    position[row * DECK_SIZE + col] += counters[w].position[row][col];
+                    adjacent[row * DECK_SIZE + col] += counters[w].adjacent[row][col];
+                }
+            }
+        }
+    } catch (const exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    double expected = static_cast<double>(shuffles) / DECK_SIZE;
+    // 位置×牌：行和列的边际都固定，自由度(52-1)^2
+    ChiSquare positionTest = testMatrix(position, false, expected, (DECK_SIZE - 1) * (DECK_SIZE - 1));
+    // 相邻牌对：52×51个单元格，各单元格并不独立，自由度近似取52×50
+    ChiSquare adjacentTest = testMatrix(adjacent, true, expected, DECK_SIZE * (DECK_SIZE - 2));
+
+    printf("engine %s, seed %llu, %llu shuffles on %d threads\n", engineName.c_str(),
+           static_cast<unsigned long long>(tableSeed), static_cast<unsigned long long>(shuffles), workers);
+    printf("%.2f s, %.0f shuffles/s\n", seconds, seconds > 0.0 ? shuffles / seconds : 0.0);
+    printResult("position x card", positionTest);
+    printResult("adjacent pairs", adjacentTest);
+    return 0;
+}
@@ -0,0 +1,292 @@
+//
+// Created for GoldenFlower table engine
+// 牌桌规则的实现：最小下注、比牌价格、轮转和结算，与界面无关
+//
+
+#include "TableState.h"
+#include "HandStrength.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+/**
+ * 入座玩家 - 替换原有的所有座位
+ * @param count 人数，[MIN_TABLE_PLAYERS, Seats]
+ * @param initialMoney 每人的初始金额
+ */
+template <int Seats>
+void BasicTableState<Seats>::seatPlayers(int count, int initialMoney) {
+    if (playing) {
+        throw invalid_argument("Cannot change seats while a hand is in progress.");
+    }
+    if (count < MIN_TABLE_PLAYERS || count > Seats) {
+        throw invalid_argument("A table seats between " + to_string(MIN_TABLE_PLAYERS) + " and " +
+                               to_string(Seats) + " players.");
+    }
+    if (initialMoney <= 0) {
+        throw invalid_argument("Initial money must be a positive integer.");
+    }
+    *this = BasicTableState();
+    seatCount = static_cast<int8_t>(count);
+    winner = -1;
+    for (int i = 0; i < count; ++i) {
+        money[i] = initialMoney;
+        status[i] = PlayerStatus::BLIND;
+    }
+}
+
+template <int Seats>
+int BasicTableState<Seats>::maxEntranceFee() const {
+    if (seatCount == 0) {
+        return 0;
+    }
+    return *min_element(money, money + seatCount) / 10;
+}
+
+template <int Seats>
+void BasicTableState<Seats>::setMinimumBet(int amount) {
+    if (amount < 0) {
+        throw invalid_argument("Minimum bet must not be negative.");
+    }
+    minimumBet = amount;
+    updateLegal();
+}
+
+template <int Seats>
+void BasicTableState<Seats>::checkStart(int entranceFee) const {
+    if (playing) {
+        throw invalid_argument("The previous hand is still in progress.");
+    }
+    if (seatCount == 0) {
+        throw invalid_argument("No players are seated.");
+    }
+    if (entranceFee < 1 || entranceFee > maxEntranceFee()) {
+        throw invalid_argument("Entrance fee must be between 1 and " + to_string(maxEntranceFee()) + ".");
+    }
+}
+
+/**
+ * 开始一局 - 入场费不计入奖池，由赢家在结算时拿走
+ * @param entranceFee 本局入场费
+ * @param dealtHands 每个座位的手牌
+ * @param dealerSeat 庄家的座位，先说话
+ * @param keys 手牌来自牌靴，可能有重复的牌，牌力改用strengthKey
+ */
+template <int Seats>
+void BasicTableState<Seats>::startHand(int entranceFee, const Hand* dealtHands, int dealerSeat, bool keys) {
+    checkStart(entranceFee);
+    if (dealerSeat < 0 || dealerSeat >= seatCount) {
+        throw invalid_argument("Dealer seat is out of range.");
+    }
+    fee = entranceFee;
+    pot = 0;
+    strengthKeys = keys;
+    for (int i = 0; i < seatCount; ++i) {
+        money[i] -= fee;
+        totalBet[i] = 0;
+        roundBet[i] = 0;
+        status[i] = PlayerStatus::BLIND;
+        hands[i] = dealtHands[i];
+        CardType type;
+        strength[i] = static_cast<uint16_t>(keys ? strengthKey(hands[i], type) : handStrength(hands[i]));
+    }
+    live = seatCount == 64 ? ~0ULL : (1ULL << seatCount) - 1;
+    dealer = static_cast<int8_t>(dealerSeat);
+    current = dealer;
+    winner = -1;
+    playing = true;
+    dealt = true;
+    updateLegal();
+}
+
+/**
+ * 上家：编号低于当前座位的最高一个未弃牌座位，没有时绕回到最高的未弃牌座位
+ * 进行中的牌局至少有两人未弃牌，掩码不会为空
+ */
+template <int Seats>
+int BasicTableState<Seats>::previousActive() const {
+    uint64_t below = live & ((1ULL << current) - 1);
+    return 63 - countLeadingZeros64(below != 0 ? below : live);
+}
+
+/**
+ * 当前玩家下注的最小金额
+ * 庄家第一次下注至少为入场费；之后看牌的玩家跟上家当轮的下注，蒙牌的玩家只需一半（向上取整）
+ * 房间设置了最小下注额时不低于它
+ */
+template <int Seats>
+int BasicTableState<Seats>::minBet() const {
+    if (current == dealer && totalBet[current] == 0) {
+        return max(fee, minimumBet);
+    }
+    int prevBet = roundBet[previousActive()];
+    if (status[current] == PlayerStatus::LOOKED) {
+        return max(prevBet, minimumBet);
+    }
+    return max((prevBet + 1) / 2, minimumBet);
+}
+
+/**
+ * 当前玩家请求比牌需要的下注
+ * 庄家第一次下注就比牌时：看牌付两倍入场费，蒙牌付入场费
+ * 否则先按双方的看牌状态折算上家当轮的下注（蒙跟看减半、看跟蒙加倍），再乘以2
+ */
+template <int Seats>
+int BasicTableState<Seats>::showdownCost() const {
+    PlayerStatus own = status[current];
+    if (current == dealer && totalBet[current] == 0) {
+        return own == PlayerStatus::LOOKED ? fee * 2 : fee;
+    }
+    int prev = previousActive();
+    int base;
+    if (status[prev] == PlayerStatus::BLIND && own == PlayerStatus::LOOKED) {
+        base = roundBet[prev] * 2;
+    } else if (status[prev] == PlayerStatus::LOOKED && own == PlayerStatus::BLIND) {
+        base = (roundBet[prev] + 1) / 2;
+    } else {
+        base = roundBet[prev];
+    }
+    return base * 2;
+}
+
+/**
+ * 重新计算当前玩家的合法操作 - 只在状态改变后调用一次，之后的查询和校验都读legal
+ */
+template <int Seats>
+void BasicTableState<Seats>::updateLegal() {
+    legal = LegalActions();
+    if (!playing) {
+        return;
+    }
+    int own = money[current];
+    legal.minBet = min(minBet(), own);
+    legal.maxBet = own;
+    legal.showdownCost = showdownCost();
+    legal.targets = live & ~(1ULL << current);
+    legal.canLook = status[current] == PlayerStatus::BLIND || status[current] == PlayerStatus::WAITING;
+    legal.canBet = true;
+    legal.canFold = true;
+    legal.canShowdown = own >= legal.showdownCost;
+}
+
+template <int Seats>
+ActionStatus BasicTableState<Seats>::look() {
+    if (!playing) {
+        return ActionStatus::NOT_IN_PROGRESS;
+    }
+    if (!legal.canLook) {
+        return ActionStatus::INVALID_ACTION;
+    }
+    status[current] = PlayerStatus::LOOKED;
+    updateLegal(); // 看牌后跟注和比牌的价格都会变
+    return ActionStatus::OK;
+}
+
+/**
+ * 当前玩家下注，然后轮到下家
+ * @param amount 下注金额，在[legal.minBet, legal.maxBet]内
+ * @return 操作结果
+ */
+template <int Seats>
+ActionStatus BasicTableState<Seats>::bet(int amount) {
+    if (!playing) {
+        return ActionStatus::NOT_IN_PROGRESS;
+    }
+    if (amount > legal.maxBet) {
+        return ActionStatus::NOT_ENOUGH_MONEY;
+    }
+    if (amount < legal.minBet) {
+        return ActionStatus::BET_TOO_SMALL;
+    }
+    if (status[current] == PlayerStatus::WAITING) {
+        status[current] = PlayerStatus::BLIND; // 没有看牌就下注视为蒙牌
+    }
+    money[current] -= amount;
+    totalBet[current] += amount;
+    roundBet[current] = amount;
+    pot += amount;
+    advance();
+    updateLegal();
+    return ActionStatus::OK;
+}
+
+template <int Seats>
+ActionStatus BasicTableState<Seats>::fold() {
+    if (!playing) {
+        return ActionStatus::NOT_IN_PROGRESS;
+    }
+    foldSeat(current);
+    if (activeCount() == 1) {
+        settle(countTrailingZeros64(live)); // 最后一个未弃牌的玩家获胜
+    } else {
+        advance();
+    }
+    updateLegal();
+    return ActionStatus::OK;
+}
+
+/**
+ * 当前玩家付出比牌的下注后与target比牌，平局算发起方输
+ * 输者弃牌；只剩一人时结算，否则轮到下家
+ * @param target 比牌对象的座位
+ * @param outcome 成功时写入比牌结果
+ * @return 操作结果
+ */
+template <int Seats>
+ActionStatus BasicTableState<Seats>::showdown(int target, ShowdownOutcome& outcome) {
+    if (!playing) {
+        return ActionStatus::NOT_IN_PROGRESS;
+    }
+    if (target < 0 || target >= seatCount || (legal.targets >> target & 1) == 0) {
+        return ActionStatus::INVALID_TARGET;
+    }
+    if (!legal.canShowdown) {
+        return ActionStatus::NOT_ENOUGH_MONEY;
+    }
+    int cost = legal.showdownCost;
+    money[current] -= cost;
+    totalBet[current] += cost;
+    roundBet[current] = cost;
+    pot += cost;
+
+    bool challengerWins = beats(current, target);
+    outcome.winner = challengerWins ? current : target;
+    outcome.loser = challengerWins ? target : current;
+    outcome.cost = cost;
+    foldSeat(outcome.loser);
+    if (activeCount() == 1) {
+        settle(outcome.winner);
+    } else {
+        advance();
+    }
+    updateLegal();
+    return ActionStatus::OK;
+}
+
+template <int Seats>
+bool BasicTableState<Seats>::beats(int seat1, int seat2) const {
+    return strengthKeys ? strengthKeyBeats(strength[seat1], strength[seat2])
+                        : strengthBeats(strength[seat1], strength[seat2]);
+}
+
+// 切换到下一个玩家 - 编号高于当前座位的最低一个未弃牌座位，没有时绕回到最低的未弃牌座位
+template <int Seats>
+void BasicTableState<Seats>::advance() {
+    uint64_t above = live & ~((2ULL << current) - 1); // current为63时above为空，绕回
+    current = static_cast<int8_t>(countTrailingZeros64(above != 0 ? above : live));
+}
+
+/**
+ * 结算 - 赢家拿走奖池和除自己以外所有玩家的入场费
+ * @param seat 赢家的座位
+ */
+template <int Seats>
+void BasicTableState<Seats>::settle(int seat) {
+    money[seat] += pot + fee * (seatCount - 1);
+    pot = 0;
+    playing = false;
+    winner = static_cast<int8_t>(seat);
+}
+
+template struct BasicTableState<MAX_TABLE_SEATS>;
+template struct BasicTableState<MAX_SHOE_SEATS>;
@@ -0,0 +1,143 @@
+//
+// Created for GoldenFlower table engine
+// 一桌牌局的全部状态：定长、可平凡复制，模拟器可以成百万张常驻内存
+// 座位数是模板参数：一副牌的牌桌（TableState）保持几百字节，牌靴牌桌（ShoeTableState）另用64座的类型
+//
+
+#ifndef POKERSERVER_TABLESTATE_H
+#define POKERSERVER_TABLESTATE_H
+
+#include <cstdint>
+#include <type_traits>
+#include "BitOps.h"
+#include "Card.h"
+#include "Deck.h"
+#include "HandStrength.h"
+
+using namespace std;
+
+// 一桌的座位数：至少两人；一副牌最多发MAX_DEAL_HANDS手
+// 牌靴牌桌最多64人，未弃牌的座位正好是一个64位掩码
+const int MIN_TABLE_PLAYERS = 2;
+const int MAX_TABLE_SEATS = MAX_DEAL_HANDS;
+const int MAX_SHOE_SEATS = 64;
+
+// 玩家状态枚举
+enum class PlayerStatus : uint8_t {
+    WAITING,    // 等待操作
+    FOLDED,     // 已弃牌
+    BLIND,      // 蒙牌
+    LOOKED      // 已看牌
+};
+
+// 玩家操作的结果：不合法的操作不改变牌桌状态
+enum class ActionStatus {
+    OK,
+    NOT_IN_PROGRESS,   // 没有进行中的牌局
+    INVALID_ACTION,    // 当前玩家不能这样操作（例如已经看过牌）
+    BET_TOO_SMALL,     // 下注低于最小金额
+    NOT_ENOUGH_MONEY,  // 余额不足
+    INVALID_TARGET     // 比牌对象不是其他未弃牌的玩家
+};
+
+// 一次比牌的结果
+struct ShowdownOutcome {
+    int winner;
+    int loser;
+    int cost;          // 发起方为比牌付出的下注
+};
+
+// 当前玩家的合法操作和金额范围，每次操作后由牌桌重新计算；校验一个操作只需几次比较
+// 没有进行中的牌局时全部为false/0。弃牌总是合法的
+struct LegalActions {
+    int32_t minBet;        // 下注范围[minBet, maxBet]，余额不足最小下注额时minBet为余额（全押）
+    int32_t maxBet;
+    int32_t showdownCost;  // 请求比牌需要的下注
+    uint64_t targets;      // 可以比牌的对象：除当前玩家外未弃牌的座位
+    bool canLook;
+    bool canBet;
+    bool canFold;
+    bool canShowdown;      // 余额够付showdownCost
+
+    bool allowsBet(int amount) const { return canBet && amount >= minBet && amount <= maxBet; }
+    bool allowsShowdown(int target) const {
+        return canShowdown && target >= 0 && target < MAX_SHOE_SEATS && (targets >> target & 1) != 0;
+    }
+};
+
+// 牌桌状态和规则：座位按列存放（结构数组），下标为座位号，不含名称等显示用的数据
+// 没有构造函数，值初始化即全零；seatPlayers之后才可使用
+// 规则：庄家先说话，轮到的玩家看牌、下注、弃牌或付费与一名对手比牌，只剩一人时结算
+// Seats为座位容量，只实例化下面两种
+template <int Seats>
+struct BasicTableState {
+    int32_t money[Seats];        // 余额
+    int32_t totalBet[Seats];     // 本局总下注
+    int32_t roundBet[Seats];     // 最近一次下注，下家按它计算最小下注
+    uint16_t strength[Seats];    // 发牌时算好的牌力或牌力键，比牌只比较整数
+    Hand hands[Seats];           // 手牌，每张牌一个字节
+    PlayerStatus status[Seats];
+    int32_t pot;                           // 奖池（不包括入场费）
+    int32_t fee;                           // 本局入场费
+    int32_t minimumBet;                    // 房间规定的最小下注额，0表示只按规则计算
+    uint64_t live;                         // 未弃牌的座位，第i位对应座位i；轮转和计数都是位运算
+    LegalActions legal;                    // 当前玩家的合法操作，由规则维护，调用方只读
+    int8_t seatCount;
+    int8_t current;                        // 轮到说话的座位
+    int8_t dealer;
+    int8_t winner;                         // 上一局的赢家，还没有结束的牌局时为-1
+    bool playing;                          // 是否有进行中的牌局
+    bool dealt;                            // hands是否已发过牌
+    bool strengthKeys;                     // strength为strengthKey（牌靴发的牌可能重复），否则为handStrength
+
+    static const int CAPACITY = Seats;
+
+    // 入座count名玩家（最多Seats人），每人initialMoney，清空其余状态；人数或金额不合法时抛出invalid_argument
+    void seatPlayers(int count, int initialMoney);
+
+    int maxEntranceFee() const; // 入场费上限：余额最少的玩家的十分之一
+    // 设置房间的最小下注额（seatPlayers会清零），为负时抛出invalid_argument
+    void setMinimumBet(int amount);
+    // 检查能否以entranceFee开始一局，不能时抛出invalid_argument
+    void checkStart(int entranceFee) const;
+    // 开始一局：收取入场费，记下手牌和牌力，dealerSeat先说话；keys表示手牌来自牌靴
+    void startHand(int entranceFee, const Hand* dealtHands, int dealerSeat, bool keys);
+
+    // 当前玩家的操作
+    ActionStatus look();                   // 看牌
+    ActionStatus bet(int amount);          // 下注，金额在[legal.minBet, legal.maxBet]内
+    ActionStatus fold();                   // 弃牌，只剩一人时结算
+    ActionStatus showdown(int target, ShowdownOutcome& outcome); // 付出legal.showdownCost与target比牌，输者弃牌
+
+    int activeCount() const { return popcount64(live); } // 未弃牌的人数
+    bool isActive(int seat) const { return (live >> seat & 1) != 0; }
+    bool beats(int seat1, int seat2) const; // seat1的牌是否大于seat2（平局不算大）
+    bool isDealer(int seat) const { return seat == dealer; }
+
+private:
+    int minBet() const;         // 按规则和房间下限计算当前玩家下注的最小金额（不考虑余额）
+    int showdownCost() const;   // 按规则计算当前玩家请求比牌需要的下注
+    void updateLegal();         // 每次操作后重新计算legal
+    int previousActive() const; // 当前玩家的上家（跳过已弃牌的玩家）
+    void advance();             // 轮到下一个未弃牌的玩家
+    void foldSeat(int seat) {
+        status[seat] = PlayerStatus::FOLDED;
+        live &= ~(1ULL << seat);
+    }
+    void settle(int seat);      // 结算：赢家拿走奖池和其余玩家的入场费
+};
+
+using TableState = BasicTableState<MAX_TABLE_SEATS>;     // 一副牌的牌桌
+using ShoeTableState = BasicTableState<MAX_SHOE_SEATS>;  // 牌靴牌桌，座位多于一副牌能发的手数
+
+extern template struct BasicTableState<MAX_TABLE_SEATS>;
+extern template struct BasicTableState<MAX_SHOE_SEATS>;
+
+static_assert(is_trivially_copyable<TableState>::value, "table state must stay trivially copyable");
+static_assert(is_trivially_copyable<ShoeTableState>::value, "table state must stay trivially copyable");
+static_assert(MAX_SHOE_SEATS <= 64, "live seats must fit in one 64-bit mask");
+static_assert(STRENGTH_KEY_SPACE <= 65536, "strength keys must fit in 16 bits");
+static_assert(sizeof(TableState) <= 384, "a one-deck table must stay within six cache lines");
+static_assert(sizeof(ShoeTableState) <= 1280, "a shoe table must stay within 20 cache lines");
+
+#endif //POKERSERVER_TABLESTATE_H
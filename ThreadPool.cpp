@@ -0,0 +1,99 @@
+//
+// Created for parallel simulation work
+//
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadCount)
+    : job(nullptr), jobTaskCount(0), nextTask(0), busyWorkers(0), generation(0), stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = hardwareThreads();
+    }
+    // 调用线程也参与计算，因此只需额外创建threadCount-1个线程
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::hardwareThreads() {
+    unsigned count = thread::hardware_concurrency();
+    return count == 0 ? 1 : static_cast<int>(count);
+}
+
+// 从共享计数器领取任务直到领完；计数器只在任务之间访问，不在内层循环中
+// body和taskCount是加锁时取得的快照，不读下一次parallelFor可能正在改写的成员
+void ThreadPool::runTasks(const function<void(int, int)>& body, int taskCount, int worker) {
+    for (;;) {
+        int task = nextTask.fetch_add(1, memory_order_relaxed);
+        if (task >= taskCount) {
+            break;
+        }
+        body(task, worker);
+    }
+}
+
+void ThreadPool::workerLoop(int worker) {
+    long long seen = 0;
+    for (;;) {
+        const function<void(int, int)>* body;
+        int taskCount;
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            // 醒得太晚时这一轮已经结束，job已清空，不再参与
+            if (job == nullptr) {
+                continue;
+            }
+            body = job;
+            taskCount = jobTaskCount;
+            ++busyWorkers;
+        }
+        runTasks(*body, taskCount, worker);
+        {
+            lock_guard<mutex> guard(lock);
+            --busyWorkers;
+        }
+        done.notify_all();
+    }
+}
+
+/**
+ * 并行执行任务 - 调用线程作为0号线程一起领取任务
+ * @param taskCount 任务数
+ * @param body 任务函数，参数为任务编号和线程编号
+ */
+void ThreadPool::parallelFor(int taskCount, const function<void(int task, int worker)>& body) {
+    if (taskCount <= 0) {
+        return;
+    }
+    {
+        lock_guard<mutex> guard(lock);
+        job = &body;
+        jobTaskCount = taskCount;
+        nextTask.store(0, memory_order_relaxed);
+        ++generation;
+    }
+    wake.notify_all();
+
+    runTasks(body, taskCount, 0);
+
+    // 等待所有领到任务的工作线程结束，之后才能释放body
+    unique_lock<mutex> guard(lock);
+    done.wait(guard, [&] { return busyWorkers == 0; });
+    job = nullptr;
+}
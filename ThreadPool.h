@@ -0,0 +1,53 @@
+//
+// Created for parallel simulation work
+//
+
+#ifndef POKERSERVER_THREADPOOL_H
+#define POKERSERVER_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// 缓存行大小：每线程累加器按此对齐，避免伪共享
+const int CACHE_LINE_SIZE = 64;
+
+// 固定大小的线程池：工作线程常驻，parallelFor把任务编号动态分给各线程
+class ThreadPool {
+public:
+    explicit ThreadPool(int threadCount = 0); // threadCount为0时使用硬件线程数
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    int size() const { return static_cast<int>(workers.size()) + 1; } // 含调用线程
+    
+    // 执行task(0..taskCount-1)，每个任务附带执行它的线程编号[0, size())，全部完成后返回
+    void parallelFor(int taskCount, const function<void(int task, int worker)>& body);
+    
+    // 硬件线程数，至少为1
+    static int hardwareThreads();
+    
+private:
+    vector<thread> workers;
+    mutex lock;
+    condition_variable wake;
+    condition_variable done;
+    const function<void(int, int)>* job;  // 当前任务，nullptr表示空闲
+    int jobTaskCount;
+    atomic<int> nextTask;
+    int busyWorkers;
+    long long generation;                 // 每提交一次任务加1，唤醒工作线程
+    bool stopping;
+    
+    void workerLoop(int worker);
+    void runTasks(const function<void(int, int)>& body, int taskCount, int worker);
+};
+
+#endif //POKERSERVER_THREADPOOL_H
@@ -0,0 +1,585 @@
+//
+// Created for hand type distribution
+// 所有概率都归结为同一个计数问题：从一副牌（或去掉一手后的49张）中发出k手互不重叠的牌，
+// 全部落在某个手牌集合S中的方案数。k = 1, 2, 3时用容斥按共用的牌精确计数：
+//   互不重叠的有序两手 = |S|² - Σ(含牌c的手数)² + Σ(含牌对p的手数)² - |S|
+// 三手则对第一手求和，第一手去掉的三张牌同样用容斥从整副牌的计数中扣除
+// 豹子、同花顺和235只涉及很小的手牌集合（"有豹子"、"有大过这手的牌"等），
+// 对任意人数都按集合中的手数容斥，集合中互不重叠的j手的方案数由逐手的状态压缩计数得到
+//
+
+#include "TypeDistribution.h"
+#include "BitOps.h"
+#include "CounterRng.h"
+#include "Deck.h"
+#include "HandIndex.h"
+#include "Showdown.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+const char TYPE_DISTRIBUTION_MAGIC[8] = {'G', 'F', 'T', 'Y', 'P', 'D', 0, 0};
+const uint32_t TYPE_DISTRIBUTION_VERSION = 3;
+const uint32_t TYPE_DISTRIBUTION_BYTE_ORDER = 0x01020304u;
+// 每行的double个数：winning、beaten和两者的置信区间半宽
+const int ROW_VALUES = 4 * CARD_TYPE_COUNT;
+// 精确计数的最大手数，更多手时用关联展开
+const int EXACT_ORDER = 3;
+
+// 牌型的大小档位：235为0，单张到同花顺为1..5，豹子为6（235反杀豹子另行处理）
+int typeLevel(CardType type) {
+    return type == CardType::SPECIAL_235 ? 0 : static_cast<int>(type) + 1;
+}
+
+// 任意人数都精确计算的牌型
+bool isExactType(int type) {
+    return type == static_cast<int>(CardType::SPECIAL_235) || type == static_cast<int>(CardType::THREE_OF_KIND) ||
+           type == static_cast<int>(CardType::STRAIGHT_FLUSH);
+}
+
+// 从n张牌中发出一手的方案数C(n,3)
+double handsFrom(int cards) {
+    return cards * (cards - 1.0) * (cards - 2.0) / 6.0;
+}
+
+// 一个手牌集合的关联计数：集合中含某张牌、含某两张牌的手数
+struct Incidence {
+    double hands = 0;
+    int card[DECK_SIZE] = {};
+    int pair[DECK_SIZE][DECK_SIZE] = {};  // 对称存放
+
+    void add(const Hand& hand) {
+        int a = hand[0].index(), b = hand[1].index(), c = hand[2].index();
+        hands += 1;
+        ++card[a]; ++card[b]; ++card[c];
+        ++pair[a][b]; ++pair[b][a];
+        ++pair[a][c]; ++pair[c][a];
+        ++pair[b][c]; ++pair[c][b];
+    }
+};
+
+// 互不重叠且都在集合中的有序两手的个数（容斥：减去共用至少一张牌的有序对）
+double disjointPairs(double hands, double cardSquares, double pairSquares) {
+    return hands * hands - cardSquares + pairSquares - hands;
+}
+
+// 整副牌上的两手计数
+double disjointPairs(const Incidence& set) {
+    double cardSquares = 0, pairSquares = 0;
+    for (int x = 0; x < DECK_SIZE; ++x) {
+        cardSquares += static_cast<double>(set.card[x]) * set.card[x];
+        for (int y = x + 1; y < DECK_SIZE; ++y) {
+            pairSquares += static_cast<double>(set.pair[x][y]) * set.pair[x][y];
+        }
+    }
+    return disjointPairs(set.hands, cardSquares, pairSquares);
+}
+
+/**
+ * 去掉一手牌后的计数 - 由整副牌上的关联计数按容斥扣除含这三张牌的手
+ * @param set 集合在整副牌上的关联计数
+ * @param member 判断三张不同的牌组成的一手是否在集合中
+ * @param removed 去掉的三张牌
+ * @param hands 输出：剩余49张中落在集合里的手数
+ * @return 剩余49张中互不重叠且都在集合中的有序两手的个数
+ */
+template <typename Member>
+double disjointPairsWithout(const Incidence& set, Member member, const int removed[3], double& hands) {
+    int a = removed[0], b = removed[1], c = removed[2];
+    auto inSet = [&](int x, int y, int z) {
+        return member(handIndex(Hand{Card::fromIndex(x), Card::fromIndex(y), Card::fromIndex(z)})) ? 1 : 0;
+    };
+    hands = set.hands - set.card[a] - set.card[b] - set.card[c] +
+            set.pair[a][b] + set.pair[a][c] + set.pair[b][c] - inSet(a, b, c);
+
+    double cardSquares = 0, pairSquares = 0;
+    for (int x = 0; x < DECK_SIZE; ++x) {
+        if (x == a || x == b || x == c) {
+            continue;
+        }
+        double degree = set.card[x] - set.pair[x][a] - set.pair[x][b] - set.pair[x][c] +
+                        inSet(x, a, b) + inSet(x, a, c) + inSet(x, b, c);
+        cardSquares += degree * degree;
+        for (int y = x + 1; y < DECK_SIZE; ++y) {
+            if (y == a || y == b || y == c) {
+                continue;
+            }
+            double degree2 = set.pair[x][y] - inSet(x, y, a) - inSet(x, y, b) - inSet(x, y, c);
+            pairSquares += degree2 * degree2;
+        }
+    }
+    return disjointPairs(hands, cardSquares, pairSquares);
+}
+
+// 小集合中两两不重叠的j手牌的无序方案数，j = 0..TYPE_DISTRIBUTION_MAX_PLAYERS
+using FamilyCounts = array<double, TYPE_DISTRIBUTION_MAX_PLAYERS + 1>;
+
+// 满足条件、且不含excluded中的牌的手牌，以牌的掩码表示
+template <typename Member>
+vector<uint64_t> handMasks(Member member, uint64_t excluded) {
+    vector<uint64_t> masks;
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        uint64_t mask = handMask(handFromIndex(i));
+        if (member(i) && (mask & excluded) == 0) {
+            masks.push_back(mask);
+        }
+    }
+    return masks;
+}
+
+/**
+ * 两两不重叠的手牌组合按手数计数 - 按最小的一张牌排序后逐手决定取或不取
+ * 状态只记已占用、且后面还有手牌会用到的牌：豹子和同花顺都只跨相邻的几个点数，
+ * 状态里只有A（A23与QKA两头都用到）和前后几个点数的牌，状态数很少
+ * @param masks 集合中的手牌，几百手以内
+ * @return 各手数的方案数
+ */
+FamilyCounts disjointFamilies(vector<uint64_t> masks) {
+    sort(masks.begin(), masks.end(),
+         [](uint64_t x, uint64_t y) { return countTrailingZeros64(x) < countTrailingZeros64(y); });
+    vector<uint64_t> usedLater(masks.size() + 1, 0);  // 第i手及以后的手牌用到的牌
+    for (size_t i = masks.size(); i-- > 0;) {
+        usedLater[i] = usedLater[i + 1] | masks[i];
+    }
+
+    unordered_map<uint64_t, FamilyCounts> states, next;
+    states[0][0] = 1.0;
+    for (size_t i = 0; i < masks.size(); ++i) {
+        next.clear();
+        for (const auto& state : states) {
+            FamilyCounts& skip = next[state.first & usedLater[i + 1]];
+            for (int j = 0; j <= TYPE_DISTRIBUTION_MAX_PLAYERS; ++j) {
+                skip[j] += state.second[j];
+            }
+            if ((state.first & masks[i]) == 0) {
+                FamilyCounts& take = next[(state.first | masks[i]) & usedLater[i + 1]];
+                for (int j = 0; j < TYPE_DISTRIBUTION_MAX_PLAYERS; ++j) {
+                    take[j + 1] += state.second[j];
+                }
+            }
+        }
+        states.swap(next);
+    }
+    FamilyCounts total{};
+    for (const auto& state : states) {
+        for (int j = 0; j <= TYPE_DISTRIBUTION_MAX_PLAYERS; ++j) {
+            total[j] += state.second[j];
+        }
+    }
+    return total;
+}
+
+// 从cards张牌中依次发出的前j手全部落在集合中的概率：有序方案数j!·f[j]除以依次发j手的方案数
+double allIn(const FamilyCounts& families, int cards, int j) {
+    double p = families[j];
+    for (int i = 0; i < j && p > 0.0; ++i) {
+        p *= (i + 1) / handsFrom(cards - 3 * i);
+    }
+    return p;
+}
+
+// 从cards张牌中发出的k手都不在集合中的概率：按落在集合中的手容斥
+double noneIn(const FamilyCounts& families, int cards, int k) {
+    double sum = 0.0, choose = 1.0;
+    for (int j = 0; j <= k; ++j) {
+        sum += (j % 2 == 0 ? choose : -choose) * allIn(families, cards, j);
+        choose = choose * (k - j) / (j + 1);
+    }
+    return min(1.0, max(0.0, sum));
+}
+
+/**
+ * k手全部落在集合中的概率 - 已知前order阶时的关联展开
+ * P(k) ≈ p1^k · g^C(k,2) · t^C(k,3)：g = p2/p1²为两手之间的修正，t = p3·p1³/p2³为三手之间的修正
+ * k ≤ order时就是已知的精确值；更多手时是外推，误差见estimateErrorBounds
+ * @param p p[k]为k手的精确概率，p[0] = 1
+ * @param order 已知的阶数
+ * @param k 手数
+ */
+double clusterProbability(const double* p, int order, int k) {
+    if (k <= order) {
+        return p[k];
+    }
+    for (int j = 1; j <= order; ++j) {
+        if (p[j] <= 0.0) {
+            return 0.0;
+        }
+    }
+    double logValue = k * log(p[1]);
+    if (order >= 2) {
+        logValue += k * (k - 1) / 2.0 * log(p[2] / (p[1] * p[1]));
+    }
+    if (order >= 3) {
+        logValue += k * (k - 1) * (k - 2) / 6.0 * log(p[3] * p[1] * p[1] * p[1] / (p[2] * p[2] * p[2]));
+    }
+    return min(1.0, exp(logValue));
+}
+
+/**
+ * 整副牌发出1..3手全部落在集合中的精确概率
+ * @param member 按组合下标的成员标记
+ * @param p 输出p[0..3]
+ */
+void fullDeckMoments(const vector<uint8_t>& member, double p[EXACT_ORDER + 1]) {
+    unique_ptr<Incidence> set(new Incidence());
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        if (member[i]) {
+            set->add(handFromIndex(i));
+        }
+    }
+    auto inSet = [&](int index) { return member[index] != 0; };
+
+    double triples = 0;
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        if (!member[i]) {
+            continue;
+        }
+        const Hand& hand = handFromIndex(i);
+        int removed[3] = {hand[0].index(), hand[1].index(), hand[2].index()};
+        double rest;
+        triples += disjointPairsWithout(*set, inSet, removed, rest);
+    }
+
+    double one = handsFrom(DECK_SIZE), two = one * handsFrom(DECK_SIZE - 3);
+    p[0] = 1.0;
+    p[1] = set->hands / one;
+    p[2] = disjointPairs(*set) / two;
+    p[3] = triples / (two * handsFrom(DECK_SIZE - 6));
+}
+
+/**
+ * 各人数下赢家牌型的分布
+ * 赢家牌型只取决于几个"全部落在集合中"的事件：
+ *   不超过某档（不含豹子时235垫底）、没有豹子、没有235、两者都没有
+ * 场上同时有豹子和235时235反杀，赢家计为235
+ * 没有豹子、没有豹子和同花顺、没有235、两者都没有、全是235按小集合精确计算；
+ * 不超过单张、对子、顺子三档用关联展开，因此单张到同花各项在4人及以上是近似值
+ */
+void computeWinning(vector<TypeDistribution>& rows) {
+    const int levels = 6;  // 档位0..5的"不超过"集合，其中1..3用关联展开
+    vector<array<double, EXACT_ORDER + 1>> moments(levels);
+    for (int top = 1; top <= 3; ++top) {
+        vector<uint8_t> set(HAND_COUNT);
+        for (int i = 0; i < HAND_COUNT; ++i) {
+            set[i] = typeLevel(handType(i)) <= top;
+        }
+        fullDeckMoments(set, moments[top].data());
+    }
+    auto typeIn = [](initializer_list<CardType> types) {
+        return disjointFamilies(handMasks(
+            [&](int i) { return find(types.begin(), types.end(), handType(i)) != types.end(); }, 0));
+    };
+    FamilyCounts leopards = typeIn({CardType::THREE_OF_KIND});
+    FamilyCounts leopardsOrStraightFlushes = typeIn({CardType::THREE_OF_KIND, CardType::STRAIGHT_FLUSH});
+    FamilyCounts specials = typeIn({CardType::SPECIAL_235});
+    FamilyCounts leopardsOrSpecials = typeIn({CardType::THREE_OF_KIND, CardType::SPECIAL_235});
+
+    for (auto& row : rows) {
+        int n = row.players;
+        double atMost[levels];
+        atMost[0] = allIn(specials, DECK_SIZE, n);
+        for (int top = 1; top <= 3; ++top) {
+            atMost[top] = clusterProbability(moments[top].data(), EXACT_ORDER, n);
+        }
+        atMost[4] = noneIn(leopardsOrStraightFlushes, DECK_SIZE, n);
+        atMost[5] = noneIn(leopards, DECK_SIZE, n);
+        double noSpecial = noneIn(specials, DECK_SIZE, n);
+        double neither = noneIn(leopardsOrSpecials, DECK_SIZE, n);
+        // 至少一个豹子且至少一个235
+        double both = max(0.0, 1.0 - atMost[levels - 1] - noSpecial + neither);
+
+        row.winning.fill(0.0);
+        row.winning[static_cast<int>(CardType::SPECIAL_235)] = atMost[0] + both;
+        row.winning[static_cast<int>(CardType::THREE_OF_KIND)] = max(0.0, 1.0 - atMost[levels - 1] - both);
+        for (int level = 1; level < levels; ++level) {
+            row.winning[level - 1] = max(0.0, atMost[level] - atMost[level - 1]);
+        }
+    }
+}
+
+/**
+ * 各人数下每种牌型被打败的概率 - 对该牌型的每一手牌求平均
+ * 单张到同花：不输给某名对手的手牌集合为牌力不超过它的牌（含235），
+ * 按牌力从小到大处理，集合的关联计数逐步累加，每手牌只需一次容斥，4人及以上按两手截断展开
+ * 豹子和同花顺：大过它的牌（更大的豹子、同花顺，豹子还有235）很少，按这个小集合精确容斥
+ * 235不输当且仅当对手中有豹子，或对手全是235，两个集合都很小，同样精确
+ */
+void computeBeaten(vector<TypeDistribution>& rows) {
+    vector<int> strengths(HAND_COUNT);
+    vector<int> order(HAND_COUNT);
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        strengths[i] = handStrength(i);
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [&](int x, int y) { return strengths[x] < strengths[y]; });
+
+    unique_ptr<Incidence> withSpecial(new Incidence());  // 牌力不超过当前的牌
+
+    array<double, CARD_TYPE_COUNT> handsOfType{};
+    vector<array<double, CARD_TYPE_COUNT>> lost(rows.size());
+    double one = handsFrom(DECK_SIZE - 3), two = one * handsFrom(DECK_SIZE - 6);
+
+    // 去掉hero后k名对手全部落在集合中的概率，k ≤ 2精确，更多时按两手截断展开
+    auto opponentsIn = [&](const Incidence& set, const int removed[3], auto member, double p[3]) {
+        double hands;
+        double pairs = disjointPairsWithout(set, member, removed, hands);
+        p[0] = 1.0;
+        p[1] = hands / one;
+        p[2] = pairs / two;
+    };
+
+    size_t next = 0;
+    while (next < order.size()) {
+        int strength = strengths[order[next]];
+        size_t end = next;
+        for (; end < order.size() && strengths[order[end]] == strength; ++end) {
+            withSpecial->add(handFromIndex(order[end]));
+        }
+
+        for (; next < end; ++next) {
+            int hero = order[next];
+            const Hand& hand = handFromIndex(hero);
+            int removed[3] = {hand[0].index(), hand[1].index(), hand[2].index()};
+            int type = static_cast<int>(handType(hero));
+            handsOfType[type] += 1;
+
+            if (isSpecial235Strength(strength)) {
+                uint64_t heroMask = handMask(hand);
+                FamilyCounts leopards = disjointFamilies(
+                    handMasks([&](int j) { return isLeopardStrength(strengths[j]); }, heroMask));
+                FamilyCounts specials = disjointFamilies(
+                    handMasks([&](int j) { return isSpecial235Strength(strengths[j]); }, heroMask));
+                for (size_t r = 0; r < rows.size(); ++r) {
+                    int k = rows[r].players - 1;
+                    lost[r][type] += noneIn(leopards, DECK_SIZE - 3, k) - allIn(specials, DECK_SIZE - 3, k);
+                }
+                continue;
+            }
+            if (isExactType(type)) {
+                FamilyCounts stronger = disjointFamilies(
+                    handMasks([&](int j) { return strengthBeats(strengths[j], strength); }, handMask(hand)));
+                for (size_t r = 0; r < rows.size(); ++r) {
+                    lost[r][type] += 1.0 - noneIn(stronger, DECK_SIZE - 3, rows[r].players - 1);
+                }
+                continue;
+            }
+
+            double safe[3];
+            opponentsIn(*withSpecial, removed, [&](int j) { return strengths[j] <= strength; }, safe);
+            for (size_t r = 0; r < rows.size(); ++r) {
+                lost[r][type] += 1.0 - clusterProbability(safe, 2, rows[r].players - 1);
+            }
+        }
+    }
+
+    for (size_t r = 0; r < rows.size(); ++r) {
+        for (int type = 0; type < CARD_TYPE_COUNT; ++type) {
+            rows[r].beaten[type] = min(1.0, max(0.0, lost[r][type] / handsOfType[type]));
+        }
+    }
+}
+
+// 模拟对照的计数：按行和牌型累加
+struct CheckCounts {
+    uint64_t winning[TYPE_DISTRIBUTION_MAX_PLAYERS + 1][CARD_TYPE_COUNT];
+    uint64_t held[TYPE_DISTRIBUTION_MAX_PLAYERS + 1][CARD_TYPE_COUNT];
+    uint64_t beaten[TYPE_DISTRIBUTION_MAX_PLAYERS + 1][CARD_TYPE_COUNT];
+};
+
+// 一个估计值的置信区间半宽：与模拟频率之差加3倍标准误；没有样本时不计
+double halfWidth(double estimate, uint64_t hits, uint64_t samples) {
+    if (samples == 0) {
+        return 0.0;
+    }
+    double frequency = static_cast<double>(hits) / samples;
+    double p = min(max(frequency, 1.0 / samples), 1.0 - 1.0 / samples);
+    return fabs(estimate - frequency) + 3.0 * sqrt(p * (1.0 - p) / samples);
+}
+
+/**
+ * 估计各项的置信区间半宽 - 精确项为0，其余项与模拟发牌对照
+ * 每次发满17手，前N手即N人的一次样本；第k段发牌使用以(种子, k)为键的Philox流，结果与线程数无关
+ * @param rows 已算好概率的各行
+ * @param deals 发牌次数
+ * @param seed 种子
+ */
+void estimateHalfWidths(vector<TypeDistribution>& rows, uint64_t deals, uint64_t seed) {
+    for (auto& row : rows) {
+        row.winningHalfWidth.fill(0.0);
+        row.beatenHalfWidth.fill(0.0);
+    }
+    if (rows.back().players <= EXACT_ORDER || deals == 0) {
+        return;
+    }
+
+    const int tasks = 256;
+    vector<CheckCounts> partial(tasks);
+    ThreadPool pool;
+    pool.parallelFor(tasks, [&](int task, int) {
+        CheckCounts& counts = partial[task];
+        memset(&counts, 0, sizeof(counts));
+        CounterRng rng(seed, static_cast<uint64_t>(task));
+        uint64_t begin = deals / tasks * task + min<uint64_t>(task, deals % tasks);
+        uint64_t end = begin + deals / tasks + (static_cast<uint64_t>(task) < deals % tasks ? 1 : 0);
+        Hand hands[MAX_DEAL_HANDS];
+        int strengths[MAX_DEAL_HANDS], types[MAX_DEAL_HANDS], order[MAX_DEAL_HANDS], place[MAX_DEAL_HANDS];
+        for (uint64_t deal = begin; deal < end; ++deal) {
+            Deck deck;
+            deck.deal(MAX_DEAL_HANDS, hands, rng);
+            for (int i = 0; i < MAX_DEAL_HANDS; ++i) {
+                int index = handIndex(hands[i]);
+                strengths[i] = handStrength(index);
+                types[i] = static_cast<int>(handType(index));
+            }
+            for (int n = EXACT_ORDER + 1; n <= TYPE_DISTRIBUTION_MAX_PLAYERS; ++n) {
+                rankShowdownStrengths(strengths, n, order, place);
+                ++counts.winning[n][types[order[0]]];
+                for (int i = 0; i < n; ++i) {
+                    ++counts.held[n][types[i]];
+                    counts.beaten[n][types[i]] += place[i] > 0 ? 1 : 0;
+                }
+            }
+        }
+    });
+
+    for (auto& row : rows) {
+        int n = row.players;
+        if (n <= EXACT_ORDER) {
+            continue;
+        }
+        for (int type = 0; type < CARD_TYPE_COUNT; ++type) {
+            if (isExactType(type)) {
+                continue;
+            }
+            uint64_t winning = 0, held = 0, beaten = 0;
+            for (const auto& counts : partial) {
+                winning += counts.winning[n][type];
+                held += counts.held[n][type];
+                beaten += counts.beaten[n][type];
+            }
+            row.winningHalfWidth[type] = halfWidth(row.winning[type], winning, deals);
+            row.beatenHalfWidth[type] = halfWidth(row.beaten[type], beaten, held);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * 计算2..17人的牌型分布
+ * 3人及以下为精确值：赢家牌型需要三手的计数，被打败的概率需要去掉自己后两名对手的计数
+ * 豹子、同花顺和235的各项对任意人数都精确；其余项在4人及以上用截断的关联展开外推
+ * （赢家牌型截断到三手，被打败截断到两手），置信区间半宽由模拟对照给出
+ * @param checkDeals 模拟对照的发牌次数
+ * @param checkSeed 模拟对照的种子，相同的种子得到相同的半宽
+ * @return 依次为2..17人
+ */
+vector<TypeDistribution> computeTypeDistributions(uint64_t checkDeals, uint64_t checkSeed) {
+    vector<TypeDistribution> rows;
+    for (int players = TYPE_DISTRIBUTION_MIN_PLAYERS; players <= TYPE_DISTRIBUTION_MAX_PLAYERS; ++players) {
+        TypeDistribution row{};
+        row.players = players;
+        rows.push_back(row);
+    }
+    computeWinning(rows);
+    computeBeaten(rows);
+    estimateHalfWidths(rows, checkDeals, checkSeed);
+    return rows;
+}
+
+/**
+ * 读取表文件
+ * 文件大小、魔数、版本、字节序和形状任一不符都拒绝加载
+ * @param path 表文件路径
+ */
+TypeDistributionTable::TypeDistributionTable(const string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        throw runtime_error("Cannot open type distribution table: " + path);
+    }
+    TypeDistributionHeader header{};
+    int count = TYPE_DISTRIBUTION_MAX_PLAYERS - TYPE_DISTRIBUTION_MIN_PLAYERS + 1;
+    vector<double> values(static_cast<size_t>(count) * ROW_VALUES);
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              fread(values.data(), sizeof(double), values.size(), file) == values.size() &&
+              fgetc(file) == EOF;
+    fclose(file);
+    bool valid = ok &&
+                 memcmp(header.magic, TYPE_DISTRIBUTION_MAGIC, sizeof(TYPE_DISTRIBUTION_MAGIC)) == 0 &&
+                 header.version == TYPE_DISTRIBUTION_VERSION &&
+                 header.byteOrder == TYPE_DISTRIBUTION_BYTE_ORDER &&
+                 header.minPlayers == static_cast<uint32_t>(TYPE_DISTRIBUTION_MIN_PLAYERS) &&
+                 header.maxPlayers == static_cast<uint32_t>(TYPE_DISTRIBUTION_MAX_PLAYERS) &&
+                 header.typeCount == static_cast<uint32_t>(CARD_TYPE_COUNT);
+    if (!valid) {
+        throw invalid_argument("Invalid type distribution table: " + path);
+    }
+
+    for (int r = 0; r < count; ++r) {
+        const double* value = &values[static_cast<size_t>(r) * ROW_VALUES];
+        TypeDistribution row{};
+        row.players = TYPE_DISTRIBUTION_MIN_PLAYERS + r;
+        for (int type = 0; type < CARD_TYPE_COUNT; ++type) {
+            row.winning[type] = value[type];
+            row.beaten[type] = value[CARD_TYPE_COUNT + type];
+            row.winningHalfWidth[type] = value[2 * CARD_TYPE_COUNT + type];
+            row.beatenHalfWidth[type] = value[3 * CARD_TYPE_COUNT + type];
+        }
+        rows.push_back(row);
+    }
+}
+
+const TypeDistribution& TypeDistributionTable::get(int players) const {
+    if (players < TYPE_DISTRIBUTION_MIN_PLAYERS || players > TYPE_DISTRIBUTION_MAX_PLAYERS) {
+        throw invalid_argument("Player count must be between 2 and 17.");
+    }
+    return rows[players - TYPE_DISTRIBUTION_MIN_PLAYERS];
+}
+
+/**
+ * 写出表文件
+ * @param path 输出路径
+ * @param rows 依次为2..17人的分布
+ */
+void TypeDistributionTable::write(const string& path, const vector<TypeDistribution>& rows) {
+    if (rows.size() != static_cast<size_t>(TYPE_DISTRIBUTION_MAX_PLAYERS - TYPE_DISTRIBUTION_MIN_PLAYERS + 1)) {
+        throw invalid_argument("Type distribution table must have one row per player count.");
+    }
+
+    TypeDistributionHeader header{};
+    memcpy(header.magic, TYPE_DISTRIBUTION_MAGIC, sizeof(TYPE_DISTRIBUTION_MAGIC));
+    header.version = TYPE_DISTRIBUTION_VERSION;
+    header.byteOrder = TYPE_DISTRIBUTION_BYTE_ORDER;
+    header.minPlayers = TYPE_DISTRIBUTION_MIN_PLAYERS;
+    header.maxPlayers = TYPE_DISTRIBUTION_MAX_PLAYERS;
+    header.typeCount = CARD_TYPE_COUNT;
+
+    vector<double> values;
+    for (size_t r = 0; r < rows.size(); ++r) {
+        if (rows[r].players != TYPE_DISTRIBUTION_MIN_PLAYERS + static_cast<int>(r)) {
+            throw invalid_argument("Type distribution rows must be ordered by player count.");
+        }
+        values.insert(values.end(), rows[r].winning.begin(), rows[r].winning.end());
+        values.insert(values.end(), rows[r].beaten.begin(), rows[r].beaten.end());
+        values.insert(values.end(), rows[r].winningHalfWidth.begin(), rows[r].winningHalfWidth.end());
+        values.insert(values.end(), rows[r].beatenHalfWidth.begin(), rows[r].beatenHalfWidth.end());
+    }
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        throw runtime_error("Cannot create type distribution table: " + path);
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(values.data(), sizeof(double), values.size(), file) == values.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        throw runtime_error("Cannot write type distribution table: " + path);
+    }
+}
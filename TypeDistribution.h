@@ -0,0 +1,67 @@
+//
+// Created for hand type distribution
+//
+
+#ifndef POKERSERVER_TYPEDISTRIBUTION_H
+#define POKERSERVER_TYPEDISTRIBUTION_H
+
+#include "HandStrength.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// 表中的人数范围：2..17人
+const int TYPE_DISTRIBUTION_MIN_PLAYERS = 2;
+const int TYPE_DISTRIBUTION_MAX_PLAYERS = 17;
+// 默认的表文件名
+const char* const TYPE_DISTRIBUTION_FILE = "type_distribution.bin";
+// 估计置信区间半宽时蒙特卡洛对照的默认发牌次数
+const uint64_t TYPE_DISTRIBUTION_CHECK_DEALS = 1ULL << 21;
+
+// 某一人数下各牌型的概率，数组按CardType下标
+struct TypeDistribution {
+    int players;
+    array<double, CARD_TYPE_COUNT> winning;  // 全场最大的一手为该牌型的概率（235反杀豹子时计为235）
+    array<double, CARD_TYPE_COUNT> beaten;   // 持该牌型的玩家输给至少一名对手的概率（平局不算输）
+    // 每个概率的置信区间半宽：真实值约以99.7%的置信落在概率±半宽内，是统计估计而不是严格上界
+    // 精确计数的项为0：3人及以下的全部项，以及任意人数下豹子、同花顺和235的项；
+    // 其余项来自截断的关联展开，半宽取与蒙特卡洛对照的偏差加3倍标准误
+    array<double, CARD_TYPE_COUNT> winningHalfWidth;
+    array<double, CARD_TYPE_COUNT> beatenHalfWidth;
+};
+
+// 计算2..17人的牌型分布，按人数排列；概率只做组合计数，
+// 4人及以上的近似项再用checkDeals次固定种子的模拟发牌对照，得到置信区间半宽
+vector<TypeDistribution> computeTypeDistributions(uint64_t checkDeals = TYPE_DISTRIBUTION_CHECK_DEALS,
+                                                  uint64_t checkSeed = 0);
+
+// 表文件头，其后紧跟每个人数一行：winning、beaten、winningHalfWidth、beatenHalfWidth各CARD_TYPE_COUNT个double
+struct TypeDistributionHeader {
+    char magic[8];           // "GFTYPD\0\0"
+    uint32_t version;
+    uint32_t byteOrder;      // 写入端的0x01020304，用于拒绝字节序不同的文件
+    uint32_t minPlayers;
+    uint32_t maxPlayers;
+    uint32_t typeCount;
+    uint32_t reserved;
+};
+
+// 牌型分布表：由TypeDistributionGenerator离线生成，只有几KB，加载时整体读入
+class TypeDistributionTable {
+public:
+    explicit TypeDistributionTable(const string& path = TYPE_DISTRIBUTION_FILE); // 读取并校验表文件
+
+    // players超出[2, 17]时抛出invalid_argument
+    const TypeDistribution& get(int players) const;
+
+    // 生成工具使用：rows必须依次为2..17人
+    static void write(const string& path, const vector<TypeDistribution>& rows);
+
+private:
+    vector<TypeDistribution> rows;
+};
+
+#endif //POKERSERVER_TYPEDISTRIBUTION_H
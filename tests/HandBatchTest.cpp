@@ -0,0 +1,101 @@
+//
+// Created for batch hand evaluator tests
+// AVX2路径和逐手路径必须给出与strengthKey完全相同的牌型和牌力键
+//
+
+#include "HandBatch.h"
+#include "TestCheck.h"
+#include <vector>
+
+namespace {
+
+// 结构数组形式的一批手牌，附带逐手的原始牌便于对照
+struct BatchData {
+    vector<uint8_t> ranks[3];
+    vector<uint8_t> suits[3];
+    vector<Hand> hands;
+
+    void add(const Hand& hand) {
+        for (int k = 0; k < 3; ++k) {
+            ranks[k].push_back(static_cast<uint8_t>(hand[k].getRank()));
+            suits[k].push_back(static_cast<uint8_t>(hand[k].getSuit()));
+        }
+        hands.push_back(hand);
+    }
+
+    HandBatch view() const {
+        HandBatch batch;
+        for (int k = 0; k < 3; ++k) {
+            batch.ranks[k] = ranks[k].data();
+            batch.suits[k] = suits[k].data();
+        }
+        batch.count = static_cast<int>(hands.size());
+        return batch;
+    }
+};
+
+// 两条路径逐手与strengthKey对照，返回不一致的手数
+int countMismatches(const BatchData& data) {
+    HandBatch batch = data.view();
+    vector<CardType> types(batch.count), scalarTypes(batch.count);
+    vector<uint16_t> keys(batch.count), scalarKeys(batch.count);
+    evaluateHandBatch(batch, types.data(), keys.data());
+    evaluateHandBatchScalar(batch, scalarTypes.data(), scalarKeys.data());
+
+    int mismatches = 0;
+    for (int i = 0; i < batch.count; ++i) {
+        CardType expectedType;
+        int expectedKey = strengthKey(data.hands[i], expectedType);
+        bool same = keys[i] == expectedKey && types[i] == expectedType && scalarKeys[i] == expectedKey &&
+                    scalarTypes[i] == expectedType;
+        if (!same && mismatches++ < 10) {
+            cerr << data.hands[i][0].toString() << ", " << data.hands[i][1].toString() << ", "
+                 << data.hands[i][2].toString() << ": key " << keys[i] << "/" << scalarKeys[i] << ", expected "
+                 << expectedKey << endl;
+        }
+    }
+    return mismatches;
+}
+
+// 牌力表中的全部22100手牌
+void testAllDistinctHands() {
+    BatchData data;
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        data.add(handFromIndex(i));
+    }
+    CHECK(countMismatches(data) == 0);
+}
+
+// 52^3种有序三张牌（含重复的牌和任意牌序），覆盖牌靴发出的手牌
+void testAllOrderedTriplesWithDuplicates() {
+    BatchData data;
+    for (int a = 0; a < 52; ++a) {
+        for (int b = 0; b < 52; ++b) {
+            for (int c = 0; c < 52; ++c) {
+                data.add(Hand{Card::fromIndex(a), Card::fromIndex(b), Card::fromIndex(c)});
+            }
+        }
+    }
+    CHECK(countMismatches(data) == 0);
+}
+
+// 手数不是16的倍数时尾部走逐手计算，边界两侧都要正确
+void testTailLengths() {
+    for (int count = 0; count <= 33; ++count) {
+        BatchData data;
+        for (int i = 0; i < count; ++i) {
+            data.add(handFromIndex((i * 7919) % HAND_COUNT));
+        }
+        CHECK(countMismatches(data) == 0);
+    }
+}
+
+} // namespace
+
+int main() {
+    cout << "AVX2 path: " << (handBatchUsesAvx2() ? "yes" : "no") << endl;
+    testAllDistinctHands();
+    testAllOrderedTriplesWithDuplicates();
+    testTailLengths();
+    return testResult("HandBatchTest");
+}
@@ -0,0 +1,179 @@
+//
+// Created for hand strength table tests
+// 牌力表取代了原GoldenFlowerWindow::compareHands，这里逐对证明两者的比较结果完全相同
+//
+
+#include "HandStrength.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// 原实现的一手牌：由牌面字符串解析，排序后的三张牌和牌型
+struct BaselineHand {
+    vector<Card> cards;
+    CardType type;
+};
+
+// 原evaluateHand：字符串解析为Card后按豹子、同花顺、同花、顺子、对子、235、单张的顺序判定
+BaselineHand evaluateBaseline(const Hand& hand) {
+    BaselineHand result;
+    for (const Card& card : hand) {
+        result.cards.push_back(Card(card.toString()));
+    }
+    const vector<Card>& cards = result.cards;
+    bool isFlush = Card::isFlush(cards);
+    bool isStraight = Card::isStraight(cards);
+    if (Card::isThreeOfAKind(cards)) {
+        result.type = CardType::THREE_OF_KIND;
+    } else if (isFlush && isStraight) {
+        result.type = CardType::STRAIGHT_FLUSH;
+    } else if (isFlush) {
+        result.type = CardType::FLUSH;
+    } else if (isStraight) {
+        result.type = CardType::STRAIGHT;
+    } else if (Card::isPair(cards)) {
+        result.type = CardType::PAIR;
+    } else if (Card::isSpecial235(cards)) {
+        result.type = CardType::SPECIAL_235;
+    } else {
+        result.type = CardType::HIGH_CARD;
+    }
+    sort(result.cards.begin(), result.cards.end());
+    return result;
+}
+
+// 原compareHands的比较规则，逐条照抄；true表示hand1大于hand2
+bool compareBaseline(const BaselineHand& h1, const BaselineHand& h2) {
+    CardType type1 = h1.type, type2 = h2.type;
+    if (type1 == CardType::SPECIAL_235 && type2 == CardType::THREE_OF_KIND) {
+        return true;
+    }
+    if (type2 == CardType::SPECIAL_235 && type1 == CardType::THREE_OF_KIND) {
+        return false;
+    }
+    if (type1 == CardType::SPECIAL_235 && type2 != CardType::THREE_OF_KIND) {
+        return false;
+    }
+    if (type2 == CardType::SPECIAL_235 && type1 != CardType::THREE_OF_KIND) {
+        return true;
+    }
+    if (type1 != type2) {
+        return static_cast<int>(type1) > static_cast<int>(type2);
+    }
+    const vector<Card>& hand1 = h1.cards;
+    const vector<Card>& hand2 = h2.cards;
+    switch (type1) {
+        case CardType::THREE_OF_KIND:
+            if (hand1[0].getRank() != hand2[0].getRank()) {
+                return static_cast<int>(hand1[0].getRank()) > static_cast<int>(hand2[0].getRank());
+            }
+            return static_cast<int>(hand1[0].getSuit()) < static_cast<int>(hand2[0].getSuit());
+        case CardType::STRAIGHT_FLUSH:
+        case CardType::STRAIGHT:
+            if (hand1[2].getRank() != hand2[2].getRank()) {
+                return static_cast<int>(hand1[2].getRank()) > static_cast<int>(hand2[2].getRank());
+            }
+            return static_cast<int>(hand1[2].getSuit()) < static_cast<int>(hand2[2].getSuit());
+        case CardType::FLUSH:
+        case CardType::HIGH_CARD:
+            for (int i = 2; i >= 0; --i) {
+                if (hand1[i].getRank() != hand2[i].getRank()) {
+                    return static_cast<int>(hand1[i].getRank()) > static_cast<int>(hand2[i].getRank());
+                }
+            }
+            return static_cast<int>(hand1[2].getSuit()) < static_cast<int>(hand2[2].getSuit());
+        case CardType::PAIR: {
+            Card pair1, pair2, single1, single2;
+            for (int i = 0; i < 2; ++i) {
+                if (hand1[i].getRank() == hand1[i + 1].getRank()) {
+                    pair1 = hand1[i];
+                    single1 = (i == 0) ? hand1[2] : hand1[0];
+                    break;
+                }
+            }
+            for (int i = 0; i < 2; ++i) {
+                if (hand2[i].getRank() == hand2[i + 1].getRank()) {
+                    pair2 = hand2[i];
+                    single2 = (i == 0) ? hand2[2] : hand2[0];
+                    break;
+                }
+            }
+            if (pair1.getRank() != pair2.getRank()) {
+                return static_cast<int>(pair1.getRank()) > static_cast<int>(pair2.getRank());
+            }
+            if (single1.getRank() != single2.getRank()) {
+                return static_cast<int>(single1.getRank()) > static_cast<int>(single2.getRank());
+            }
+            return static_cast<int>(pair1.getSuit()) < static_cast<int>(pair2.getSuit());
+        }
+        default:
+            return false;
+    }
+}
+
+bool tableBeats(const Hand& hand1, const Hand& hand2) {
+    return strengthBeats(handStrength(hand1), handStrength(hand2));
+}
+
+// 全部22100×22100对组合：牌型和比较结果都必须与原实现相同
+void testAllPairsMatchBaseline() {
+    vector<BaselineHand> baseline;
+    vector<int> strength(HAND_COUNT);
+    baseline.reserve(HAND_COUNT);
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        baseline.push_back(evaluateBaseline(handFromIndex(i)));
+        strength[i] = handStrength(i);
+        CHECK(handType(i) == baseline[i].type);
+        CHECK(strengthType(strength[i]) == baseline[i].type);
+    }
+    long long mismatches = 0;
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        for (int j = 0; j < HAND_COUNT; ++j) {
+            if (strengthBeats(strength[i], strength[j]) != compareBaseline(baseline[i], baseline[j])) {
+                if (mismatches++ < 10) {
+                    cerr << handFromIndex(i)[0].toString() << ", " << handFromIndex(i)[1].toString() << ", "
+                         << handFromIndex(i)[2].toString() << " vs " << handFromIndex(j)[0].toString() << ", "
+                         << handFromIndex(j)[1].toString() << ", " << handFromIndex(j)[2].toString() << endl;
+                }
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// 规则中容易出错的几处，单独列出便于定位
+void testSpecialRules() {
+    const Hand a23 = {Card(Rank::ACE, Suit::HEARTS), Card(Rank::TWO, Suit::CLUBS), Card(Rank::THREE, Suit::SPADES)};
+    const Hand s234 = {Card(Rank::TWO, Suit::HEARTS), Card(Rank::THREE, Suit::CLUBS), Card(Rank::FOUR, Suit::SPADES)};
+    const Hand s235 = {Card(Rank::TWO, Suit::HEARTS), Card(Rank::THREE, Suit::CLUBS), Card(Rank::FIVE, Suit::SPADES)};
+    const Hand other235 = {Card(Rank::TWO, Suit::SPADES), Card(Rank::THREE, Suit::HEARTS),
+                           Card(Rank::FIVE, Suit::CLUBS)};
+    const Hand leopard = {Card(Rank::ACE, Suit::HEARTS), Card(Rank::ACE, Suit::SPADES), Card(Rank::ACE, Suit::CLUBS)};
+    const Hand highCard = {Card(Rank::TWO, Suit::CLUBS), Card(Rank::FOUR, Suit::HEARTS), Card(Rank::SEVEN, Suit::SPADES)};
+    const Hand pairHearts = {Card(Rank::NINE, Suit::HEARTS), Card(Rank::NINE, Suit::CLUBS),
+                             Card(Rank::KING, Suit::SPADES)};
+    const Hand pairSpades = {Card(Rank::NINE, Suit::SPADES), Card(Rank::NINE, Suit::DIAMONDS),
+                             Card(Rank::KING, Suit::HEARTS)};
+
+    CHECK(handType(a23) == CardType::STRAIGHT);
+    CHECK(tableBeats(a23, s234));  // 原实现按排序后最大的一张比较，A23视为A高的顺子
+    CHECK(handType(s235) == CardType::SPECIAL_235);
+    CHECK(tableBeats(s235, leopard));
+    CHECK(!tableBeats(leopard, s235));
+    CHECK(tableBeats(highCard, s235));
+    CHECK(!tableBeats(s235, other235));
+    CHECK(!tableBeats(other235, s235));
+    // 对子点数和单牌都相同时比对子里较小那张的花色：梅花 < 方块
+    CHECK(tableBeats(pairSpades, pairHearts));
+    CHECK(!tableBeats(pairHearts, pairSpades));
+}
+
+} // namespace
+
+int main() {
+    testSpecialRules();
+    testAllPairsMatchBaseline();
+    return testResult("HandStrengthTest");
+}
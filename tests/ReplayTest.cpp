@@ -0,0 +1,153 @@
+//
+// Created for deal replay tests
+// 每种引擎下，由lastDealSeed()回放得到的手牌必须与当时发出的完全相同；真钱牌桌还要加上lastDealKey()
+//
+
+#include "PokerGame.h"
+#include "TestCheck.h"
+
+namespace {
+
+const RngEngine ENGINES[] = {RngEngine::XOSHIRO256, RngEngine::PCG64, RngEngine::CHACHA20, RngEngine::PHILOX};
+const int HANDS_PER_ENGINE = 200;
+
+bool sameHands(const vector<Hand>& a, const vector<Hand>& b) {
+    return a == b;
+}
+
+// 一副牌：固定种子0（第0局时种子等于流编号，曾使xoshiro的状态全为零）和熵源种子
+void testSingleDeckReplay() {
+    for (RngEngine engine : ENGINES) {
+        GameLogic fixed(engine, 0);
+        GameLogic seeded(engine);
+        for (int hand = 0; hand < HANDS_PER_ENGINE; ++hand) {
+            int players = 1 + hand % MAX_DEAL_HANDS;
+            for (GameLogic* game : {&fixed, &seeded}) {
+                game->resetDeck();
+                vector<Hand> dealt = game->dealCards(players);
+                if (game->lastDealKeyed()) {  // 熵源播种的CHACHA20牌桌
+                    CHECK(sameHands(GameLogic::replayDeal(game->lastDealKey(), game->lastDealSeed(), players), dealt));
+                    continue;
+                }
+                CHECK(sameHands(GameLogic::replayDeal(engine, game->lastDealSeed(), players), dealt));
+                CHECK(sameHands(GameLogic::replayDeal(engine, game->lastDealSeed(), players, 1), dealt));
+            }
+        }
+        CHECK(fixed.lastDealSeed().tableSeed == 0);
+        CHECK(fixed.lastDealSeed().handNumber == HANDS_PER_ENGINE - 1);
+    }
+}
+
+// 不分配内存的发牌接口走同一条路径
+void testBufferOverloadReplay() {
+    for (RngEngine engine : ENGINES) {
+        GameLogic game(engine, 12345);
+        array<Hand, MAX_DEAL_HANDS> hands;
+        CHECK(game.dealCards(MAX_DEAL_HANDS, hands) == DealStatus::OK);
+        vector<Hand> replayed = GameLogic::replayDeal(engine, game.lastDealSeed(), MAX_DEAL_HANDS);
+        CHECK(sameHands(replayed, vector<Hand>(hands.begin(), hands.end())));
+    }
+}
+
+// 多副牌的牌靴：人数超过17
+void testShoeReplay() {
+    for (RngEngine engine : ENGINES) {
+        for (int decks : {2, 6, MAX_SHOE_DECKS}) {
+            GameLogic game(engine, 7);
+            game.useShoe(decks);
+            for (int hand = 0; hand < 20; ++hand) {
+                int players = MAX_DEAL_HANDS + 1 + hand % (decks * DECK_SIZE / 3 - MAX_DEAL_HANDS);
+                game.resetDeck();
+                vector<Hand> dealt = game.dealCards(players);
+                CHECK(sameHands(GameLogic::replayDeal(engine, game.lastDealSeed(), players, decks), dealt));
+            }
+        }
+    }
+}
+
+// 预洗牌池：池中整副洗好的牌与现洗时只洗前几个位置的结果相同
+void testDeckPoolReplay() {
+    for (RngEngine engine : ENGINES) {
+        DeckPool pool(engine, 16, 99);
+        GameLogic game(engine, 99);
+        game.useDeckPool(&pool);
+        for (int hand = 0; hand < 50; ++hand) {
+            int players = 1 + hand % MAX_DEAL_HANDS;
+            game.resetDeck();
+            vector<Hand> dealt = game.dealCards(players);
+            CHECK(sameHands(GameLogic::replayDeal(engine, game.lastDealSeed(), players), dealt));
+        }
+    }
+}
+
+// 真钱牌桌：每局一个熵源密钥，回放需要密钥；固定种子的牌桌不带密钥
+void testSecureKeyReplay() {
+    GameLogic secure(RngEngine::CHACHA20);
+    DeckPool securePool(RngEngine::CHACHA20, 16);
+    DealKey previous = DealKey();
+    for (int hand = 0; hand < HANDS_PER_ENGINE; ++hand) {
+        int players = 1 + hand % MAX_DEAL_HANDS;
+        secure.useDeckPool(hand % 2 == 0 ? nullptr : &securePool);
+        secure.resetDeck();
+        vector<Hand> dealt = secure.dealCards(players);
+        CHECK(secure.lastDealKeyed());
+        CHECK(secure.lastDealKey().words != previous.words);
+        previous = secure.lastDealKey();
+        CHECK(sameHands(GameLogic::replayDeal(secure.lastDealKey(), secure.lastDealSeed(), players), dealt));
+    }
+
+    secure.useDeckPool(nullptr);
+    secure.useShoe(3);
+    for (int hand = 0; hand < 20; ++hand) {
+        int players = MAX_DEAL_HANDS + 1 + hand % (3 * DECK_SIZE / 3 - MAX_DEAL_HANDS);
+        secure.resetDeck();
+        vector<Hand> dealt = secure.dealCards(players);
+        CHECK(secure.lastDealKeyed());
+        CHECK(sameHands(GameLogic::replayDeal(secure.lastDealKey(), secure.lastDealSeed(), players, 3), dealt));
+    }
+
+    GameLogic fixed(RngEngine::CHACHA20, 5);
+    fixed.dealCards(3);
+    CHECK(!fixed.lastDealKeyed());
+}
+
+// 部分洗牌的前depth个位置与完整洗牌相同，且整副仍是一个排列
+void testPartialShufflePrefix() {
+    for (RngEngine engine : ENGINES) {
+        for (uint64_t hand = 0; hand < 50; ++hand) {
+            DealSeed seed{3, hand};
+            ShuffledDeck full = ShuffledDeck::fromSeed(engine, seed);
+            for (int depth = 0; depth <= DECK_SIZE; depth += 3) {
+                ShuffledDeck partial = ShuffledDeck::fromSeed(engine, seed, depth);
+                CHECK(equal(partial.order.begin(), partial.order.begin() + depth, full.order.begin()));
+                uint64_t seen = 0;
+                for (uint8_t card : partial.order) {
+                    seen |= 1ULL << card;
+                }
+                CHECK(seen == FULL_DECK_MASK);
+            }
+        }
+    }
+}
+
+// 交换种子和流编号得到不同的牌序
+void testSwappedSeedAndStream() {
+    for (RngEngine engine : ENGINES) {
+        ShuffledDeck a = ShuffledDeck::fromSeed(engine, DealSeed{1, 2});
+        ShuffledDeck b = ShuffledDeck::fromSeed(engine, DealSeed{2, 1});
+        CHECK(a.order != b.order);
+    }
+}
+
+} // namespace
+
+int main() {
+    testSingleDeckReplay();
+    testBufferOverloadReplay();
+    testShoeReplay();
+    testDeckPoolReplay();
+    testSecureKeyReplay();
+    testPartialShufflePrefix();
+    testSwappedSeedAndStream();
+    return testResult("ReplayTest");
+}
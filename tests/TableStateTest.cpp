@@ -0,0 +1,502 @@
+//
+// Created for table rule tests
+// 规则用逐步脚本固定下来；再把按座位存放玩家的原GameTable规则照搬为参考实现，
+// 随机操作序列下每一步都与TableState/GameTable对照：结构数组、位掩码轮转和合法操作表必须不改变任何结果
+//
+
+#include "GameTable.h"
+#include "HandStrength.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const Hand HIGH_AK7 = {Card(Rank::ACE, Suit::HEARTS), Card(Rank::KING, Suit::CLUBS), Card(Rank::SEVEN, Suit::SPADES)};
+const Hand PAIR_99 = {Card(Rank::NINE, Suit::HEARTS), Card(Rank::NINE, Suit::CLUBS), Card(Rank::KING, Suit::SPADES)};
+const Hand LEOPARD_AAA = {Card(Rank::ACE, Suit::SPADES), Card(Rank::ACE, Suit::DIAMONDS), Card(Rank::ACE, Suit::CLUBS)};
+const Hand SPECIAL_235 = {Card(Rank::TWO, Suit::HEARTS), Card(Rank::THREE, Suit::CLUBS), Card(Rank::FIVE, Suit::SPADES)};
+const Hand OTHER_235 = {Card(Rank::TWO, Suit::SPADES), Card(Rank::THREE, Suit::HEARTS), Card(Rank::FIVE, Suit::CLUBS)};
+
+TableState seatedTable(int count, int money) {
+    TableState table = TableState();
+    table.seatPlayers(count, money);
+    return table;
+}
+
+// 最小下注：庄家第一次为入场费；蒙牌跟上家的一半（向上取整），看牌跟满
+void testMinimumBets() {
+    TableState table = seatedTable(3, 1000);
+    Hand hands[3] = {HIGH_AK7, PAIR_99, LEOPARD_AAA};
+    table.startHand(10, hands, 0, false);
+    CHECK(table.money[0] == 990 && table.money[1] == 990 && table.money[2] == 990);
+    CHECK(table.current == 0);
+    CHECK(table.legal.minBet == 10);
+    CHECK(table.bet(9) == ActionStatus::BET_TOO_SMALL);
+    CHECK(table.bet(991) == ActionStatus::NOT_ENOUGH_MONEY);
+    CHECK(table.current == 0 && table.pot == 0);
+
+    CHECK(table.bet(15) == ActionStatus::OK);
+    CHECK(table.current == 1);
+    CHECK(table.legal.minBet == 8);       // 蒙牌：(15 + 1) / 2
+    CHECK(table.look() == ActionStatus::OK);
+    CHECK(table.look() == ActionStatus::INVALID_ACTION);
+    CHECK(table.legal.minBet == 15);      // 看牌：跟满
+    CHECK(table.bet(14) == ActionStatus::BET_TOO_SMALL);
+    CHECK(table.bet(15) == ActionStatus::OK);
+    CHECK(table.current == 2);
+    CHECK(table.legal.minBet == 8);
+    CHECK(table.pot == 30);
+
+    // 余额不足最小下注额时只能全押
+    table.money[2] = 5;
+    table.look();
+    CHECK(table.legal.minBet == 5 && table.legal.maxBet == 5);
+    CHECK(table.bet(5) == ActionStatus::OK);
+    CHECK(table.money[2] == 0);
+}
+
+// 房间最小下注额抬高规则算出的最小值
+void testRoomMinimumBet() {
+    TableState table = seatedTable(2, 1000);
+    table.setMinimumBet(50);
+    Hand hands[2] = {HIGH_AK7, PAIR_99};
+    table.startHand(10, hands, 1, false);
+    CHECK(table.current == 1);
+    CHECK(table.legal.minBet == 50);
+    CHECK(table.bet(50) == ActionStatus::OK);
+    CHECK(table.legal.minBet == 50);      // 蒙牌的一半25低于房间下限
+}
+
+// 比牌价格：庄家第一次比牌蒙牌付入场费、看牌付两倍；之后按看牌状态折算上家的下注再乘2
+void testShowdownCost() {
+    TableState table = seatedTable(3, 1000);
+    Hand hands[3] = {HIGH_AK7, PAIR_99, LEOPARD_AAA};
+    table.startHand(10, hands, 0, false);
+    CHECK(table.legal.showdownCost == 10);
+    table.look();
+    CHECK(table.legal.showdownCost == 20);
+    CHECK(table.bet(12) == ActionStatus::OK);   // 看牌下注12
+
+    CHECK(table.legal.showdownCost == 12);      // 蒙牌跟看牌：(12 + 1) / 2 = 6，再乘2
+    table.look();
+    CHECK(table.legal.showdownCost == 24);      // 看牌跟看牌
+    CHECK(table.bet(12) == ActionStatus::OK);
+
+    CHECK(table.current == 2);
+    CHECK(table.legal.showdownCost == 12);
+    CHECK(table.legal.targets == 0x3u);
+    CHECK(table.legal.canShowdown);
+    CHECK(!table.legal.allowsShowdown(2));
+
+    TableState blindChain = seatedTable(2, 1000);
+    blindChain.startHand(10, hands, 0, false);
+    blindChain.bet(30);                          // 蒙牌下注30
+    CHECK(blindChain.legal.showdownCost == 60);  // 蒙牌跟蒙牌
+    blindChain.look();
+    CHECK(blindChain.legal.showdownCost == 120); // 看牌跟蒙牌：加倍后再乘2
+}
+
+// 比牌：输者弃牌，平局算发起方输；只剩一人时结算
+void testShowdownAndSettlement() {
+    TableState table = seatedTable(3, 1000);
+    Hand hands[3] = {SPECIAL_235, PAIR_99, OTHER_235};
+    table.startHand(10, hands, 0, false);
+    CHECK(table.bet(10) == ActionStatus::OK);    // 座位0蒙牌10
+    CHECK(table.bet(5) == ActionStatus::OK);     // 座位1蒙牌5
+
+    ShowdownOutcome outcome{};
+    CHECK(table.showdown(2, outcome) == ActionStatus::INVALID_TARGET);  // 不能和自己比
+    CHECK(table.showdown(3, outcome) == ActionStatus::INVALID_TARGET);
+    CHECK(table.showdown(0, outcome) == ActionStatus::OK);             // 235对235，平局
+    CHECK(outcome.winner == 0 && outcome.loser == 2 && outcome.cost == 10);
+    CHECK(table.status[2] == PlayerStatus::FOLDED);
+    CHECK(table.activeCount() == 2 && table.playing);
+    CHECK(table.current == 0);
+
+    CHECK(table.showdown(2, outcome) == ActionStatus::INVALID_TARGET);  // 已弃牌
+    CHECK(table.fold() == ActionStatus::OK);
+    CHECK(!table.playing);
+    CHECK(table.winner == 1);
+    // 赢家拿走奖池（10 + 5 + 10）和其余两人的入场费
+    CHECK(table.money[0] == 980);
+    CHECK(table.money[1] == 990 - 5 + 25 + 20);
+    CHECK(table.money[2] == 980);
+    CHECK(table.pot == 0);
+    CHECK(table.bet(10) == ActionStatus::NOT_IN_PROGRESS);
+    CHECK(table.fold() == ActionStatus::NOT_IN_PROGRESS);
+    CHECK(!table.legal.canBet && !table.legal.canFold);
+}
+
+// 235只反杀豹子；发起方牌大时赢
+void testSpecial235AgainstLeopard() {
+    TableState table = seatedTable(2, 1000);
+    Hand hands[2] = {SPECIAL_235, LEOPARD_AAA};
+    table.startHand(10, hands, 0, false);
+    CHECK(table.beats(0, 1));
+    CHECK(!table.beats(1, 0));
+    ShowdownOutcome outcome{};
+    CHECK(table.showdown(1, outcome) == ActionStatus::OK);
+    CHECK(outcome.winner == 0 && !table.playing && table.winner == 0);
+
+    Hand other[2] = {SPECIAL_235, HIGH_AK7};
+    table.startHand(10, other, 0, false);
+    CHECK(!table.beats(0, 1));
+    CHECK(table.showdown(1, outcome) == ActionStatus::OK);
+    CHECK(outcome.winner == 1 && table.winner == 1);
+}
+
+// 原GameTable的规则：座位是对象数组，轮转逐个跳过弃牌的玩家
+struct ReferencePlayer {
+    Hand cards;
+    int money;
+    int currentBet;
+    int currentRoundBet;
+    PlayerStatus status;
+    bool isDealer;
+};
+
+struct ReferenceTable {
+    vector<ReferencePlayer> seats;
+    int current = 0, pot = 0, fee = 0, minimumBet = 0, winner = -1;
+    bool playing = false, keys = false;
+
+    ReferenceTable(int count, int money) : seats(count, ReferencePlayer{Hand{}, money, 0, 0, PlayerStatus::BLIND, false}) {}
+
+    int n() const { return static_cast<int>(seats.size()); }
+    int maxEntranceFee() const {
+        int lowest = seats[0].money;
+        for (const auto& seat : seats) {
+            lowest = min(lowest, seat.money);
+        }
+        return lowest / 10;
+    }
+
+    void startHand(int entranceFee, const Hand* hands, int dealer, bool fromShoe) {
+        fee = entranceFee;
+        pot = 0;
+        keys = fromShoe;
+        for (int i = 0; i < n(); ++i) {
+            seats[i] = ReferencePlayer{hands[i], seats[i].money - fee, 0, 0, PlayerStatus::BLIND, i == dealer};
+        }
+        current = dealer;
+        playing = true;
+        winner = -1;
+    }
+
+    int activeCount() const {
+        int count = 0;
+        for (const auto& seat : seats) {
+            count += seat.status != PlayerStatus::FOLDED ? 1 : 0;
+        }
+        return count;
+    }
+    int previousActive() const {
+        int seat = (current - 1 + n()) % n();
+        while (seats[seat].status == PlayerStatus::FOLDED) {
+            seat = (seat - 1 + n()) % n();
+        }
+        return seat;
+    }
+    void advance() {
+        do {
+            current = (current + 1) % n();
+        } while (seats[current].status == PlayerStatus::FOLDED);
+    }
+    void settle(int seat) {
+        seats[seat].money += pot + fee * (n() - 1);
+        pot = 0;
+        playing = false;
+        winner = seat;
+    }
+    bool beats(int seat1, int seat2) const {
+        CardType type;
+        if (keys) {
+            return strengthKeyBeats(strengthKey(seats[seat1].cards, type), strengthKey(seats[seat2].cards, type));
+        }
+        return strengthBeats(handStrength(seats[seat1].cards), handStrength(seats[seat2].cards));
+    }
+    int minBet() const {
+        const ReferencePlayer& player = seats[current];
+        if (player.isDealer && player.currentBet == 0) {
+            return max(fee, minimumBet);
+        }
+        const ReferencePlayer& prev = seats[previousActive()];
+        if (player.status == PlayerStatus::LOOKED) {
+            return max(prev.currentRoundBet, minimumBet);
+        }
+        return max((prev.currentRoundBet + 1) / 2, minimumBet);
+    }
+    int showdownCost() const {
+        const ReferencePlayer& player = seats[current];
+        if (player.isDealer && player.currentBet == 0) {
+            return player.status == PlayerStatus::LOOKED ? fee * 2 : fee;
+        }
+        const ReferencePlayer& prev = seats[previousActive()];
+        int base;
+        if (prev.status == PlayerStatus::BLIND && player.status == PlayerStatus::LOOKED) {
+            base = prev.currentRoundBet * 2;
+        } else if (prev.status == PlayerStatus::LOOKED && player.status == PlayerStatus::BLIND) {
+            base = (prev.currentRoundBet + 1) / 2;
+        } else {
+            base = prev.currentRoundBet;
+        }
+        return base * 2;
+    }
+    void placeBet(int amount) {
+        ReferencePlayer& player = seats[current];
+        player.money -= amount;
+        player.currentBet += amount;
+        player.currentRoundBet = amount;
+        pot += amount;
+    }
+
+    ActionStatus look() {
+        if (!playing) {
+            return ActionStatus::NOT_IN_PROGRESS;
+        }
+        ReferencePlayer& player = seats[current];
+        if (player.status != PlayerStatus::BLIND && player.status != PlayerStatus::WAITING) {
+            return ActionStatus::INVALID_ACTION;
+        }
+        player.status = PlayerStatus::LOOKED;
+        return ActionStatus::OK;
+    }
+    ActionStatus bet(int amount) {
+        if (!playing) {
+            return ActionStatus::NOT_IN_PROGRESS;
+        }
+        if (amount > seats[current].money) {
+            return ActionStatus::NOT_ENOUGH_MONEY;
+        }
+        if (amount < min(minBet(), seats[current].money)) {
+            return ActionStatus::BET_TOO_SMALL;
+        }
+        placeBet(amount);
+        advance();
+        return ActionStatus::OK;
+    }
+    ActionStatus fold() {
+        if (!playing) {
+            return ActionStatus::NOT_IN_PROGRESS;
+        }
+        seats[current].status = PlayerStatus::FOLDED;
+        if (activeCount() == 1) {
+            for (int i = 0; i < n(); ++i) {
+                if (seats[i].status != PlayerStatus::FOLDED) {
+                    settle(i);
+                }
+            }
+        } else {
+            advance();
+        }
+        return ActionStatus::OK;
+    }
+    ActionStatus showdown(int target, ShowdownOutcome& outcome) {
+        if (!playing) {
+            return ActionStatus::NOT_IN_PROGRESS;
+        }
+        if (target < 0 || target >= n() || target == current || seats[target].status == PlayerStatus::FOLDED) {
+            return ActionStatus::INVALID_TARGET;
+        }
+        int cost = showdownCost();
+        if (seats[current].money < cost) {
+            return ActionStatus::NOT_ENOUGH_MONEY;
+        }
+        placeBet(cost);
+        bool challengerWins = beats(current, target);
+        outcome.winner = challengerWins ? current : target;
+        outcome.loser = challengerWins ? target : current;
+        outcome.cost = cost;
+        seats[outcome.loser].status = PlayerStatus::FOLDED;
+        if (activeCount() == 1) {
+            settle(outcome.winner);
+        } else {
+            advance();
+        }
+        return ActionStatus::OK;
+    }
+};
+
+// 牌桌状态与参考实现逐项相同，包括由规则推出的合法操作表
+template <int Seats>
+bool sameState(const BasicTableState<Seats>& table, const ReferenceTable& reference) {
+    bool same = table.playing == reference.playing && table.pot == reference.pot &&
+                table.winner == reference.winner && table.activeCount() == reference.activeCount();
+    for (int i = 0; i < reference.n(); ++i) {
+        const ReferencePlayer& seat = reference.seats[i];
+        same = same && table.money[i] == seat.money && table.totalBet[i] == seat.currentBet &&
+               table.roundBet[i] == seat.currentRoundBet && table.status[i] == seat.status &&
+               table.isActive(i) == (seat.status != PlayerStatus::FOLDED) && table.hands[i] == seat.cards;
+    }
+    if (!reference.playing) {
+        return same && !table.legal.canBet;
+    }
+    const ReferencePlayer& player = reference.seats[reference.current];
+    uint64_t targets = 0;
+    for (int i = 0; i < reference.n(); ++i) {
+        if (i != reference.current && reference.seats[i].status != PlayerStatus::FOLDED) {
+            targets |= 1ULL << i;
+        }
+    }
+    int cost = reference.showdownCost();
+    return same && table.current == reference.current && table.legal.minBet == min(reference.minBet(), player.money) &&
+           table.legal.maxBet == player.money && table.legal.showdownCost == cost &&
+           table.legal.canShowdown == (player.money >= cost) && table.legal.targets == targets &&
+           table.legal.canLook == (player.status == PlayerStatus::BLIND || player.status == PlayerStatus::WAITING);
+}
+
+/**
+ * 随机操作序列 - 包括不合法的下注、比牌对象和重复看牌，每一步的返回值和状态都要相同
+ * 手牌来自GameTable自己的发牌，并且必须能由handSeed()回放出来
+ * @param seats 座位数
+ * @param decks 牌靴副数，1为单副牌
+ * @param hands 打的局数
+ * @param seed 牌桌种子
+ */
+template <typename Table>
+void fuzzAgainstReference(int seats, int decks, int hands, uint64_t seed) {
+    Table game(RngEngine::XOSHIRO256, seed);
+    if (decks > 1) {
+        game.useShoe(decks);
+    }
+    game.seatPlayers(seats, 2000);
+    ReferenceTable reference(seats, 2000);
+    Xoshiro256 choices(seed, 1);
+    const int fee = 10;
+    int divergences = 0;
+
+    for (int hand = 0; hand < hands && divergences == 0; ++hand) {
+        if (game.state().maxEntranceFee() < fee) {
+            game.seatPlayers(seats, 2000);
+            reference = ReferenceTable(seats, 2000);
+        }
+        game.startHand(fee);
+        const typename Table::State& table = game.state();
+        vector<Hand> replayed = GameLogic::replayDeal(RngEngine::XOSHIRO256, game.handSeed(), seats, decks);
+        CHECK(equal(replayed.begin(), replayed.end(), table.hands));
+        reference.startHand(fee, table.hands, table.dealer, decks > 1);
+        if (!sameState(table, reference)) {
+            ++divergences;
+        }
+
+        for (int step = 0; table.playing && step < 400 && divergences == 0; ++step) {
+            int kind = static_cast<int>(uniformBelow(choices, 20));
+            ActionStatus expected, actual;
+            if (kind < 3) {
+                expected = reference.look();
+                actual = game.look();
+            } else if (kind < 4) {
+                expected = reference.fold();
+                actual = game.fold();
+            } else if (kind < 14) {
+                int money = reference.seats[reference.current].money;
+                int low = min(reference.minBet(), money);
+                int candidates[5] = {low - 1, low, low + static_cast<int>(uniformBelow(choices, 40)), money, money + 1};
+                int amount = candidates[uniformBelow(choices, 5)];
+                expected = reference.bet(amount);
+                actual = game.bet(amount);
+            } else {
+                int target = static_cast<int>(uniformBelow(choices, static_cast<uint32_t>(seats + 2))) - 1;
+                ShowdownOutcome expectedOutcome{}, actualOutcome{};
+                expected = reference.showdown(target, expectedOutcome);
+                actual = game.showdown(target, actualOutcome);
+                if (expected == ActionStatus::OK && (expectedOutcome.winner != actualOutcome.winner ||
+                                                     expectedOutcome.loser != actualOutcome.loser ||
+                                                     expectedOutcome.cost != actualOutcome.cost)) {
+                    ++divergences;
+                }
+            }
+            if (expected != actual || !sameState(table, reference)) {
+                ++divergences;
+            }
+        }
+        // 没打完的局全部弃牌结束
+        while (table.playing && divergences == 0) {
+            reference.fold();
+            game.fold();
+            if (!sameState(table, reference)) {
+                ++divergences;
+            }
+        }
+    }
+    if (divergences != 0) {
+        cerr << "diverged from the reference rules: " << seats << " seats, " << decks << " decks, seed " << seed
+             << endl;
+    }
+    CHECK(divergences == 0);
+}
+
+void testAgainstReference() {
+    for (int seats = MIN_TABLE_PLAYERS; seats <= MAX_DEAL_HANDS; ++seats) {
+        fuzzAgainstReference<GameTable>(seats, 1, 300, static_cast<uint64_t>(seats));
+    }
+    // 一副牌的牌桌也可以用牌靴发牌（手牌可能重复）
+    fuzzAgainstReference<GameTable>(MAX_TABLE_SEATS, 2, 100, 99);
+    // 牌靴牌桌：掩码的32位和64位边界两侧
+    for (int seats : {MIN_TABLE_PLAYERS, MAX_DEAL_HANDS + 1, 31, 32, 33, 63, MAX_SHOE_SEATS}) {
+        fuzzAgainstReference<ShoeGameTable>(seats, 4, 100, static_cast<uint64_t>(seats));
+    }
+}
+
+// 一副牌的牌桌最多MAX_TABLE_SEATS座；牌靴牌桌超过一副牌的座位需要牌靴，满64座时轮转从63号绕回0号
+void testShoeTables() {
+    GameTable small(RngEngine::XOSHIRO256, 4);
+    bool rejected = false;
+    try {
+        small.seatPlayers(MAX_TABLE_SEATS + 1, 1000);
+    } catch (const invalid_argument&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+
+    ShoeGameTable single(RngEngine::XOSHIRO256, 5);
+    single.seatPlayers(MAX_DEAL_HANDS + 1, 1000);
+    bool threw = false;
+    try {
+        single.startHand(10);
+    } catch (const invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(!single.state().playing);
+
+    single.useShoe(2);
+    single.startHand(10);
+    CHECK(single.state().playing && single.state().strengthKeys);
+
+    ShoeGameTable full(RngEngine::PCG64, 6);
+    full.useShoe(4);
+    full.seatPlayers(MAX_SHOE_SEATS, 1000);
+    full.startHand(10);
+    const ShoeTableState& table = full.state();
+    CHECK(table.activeCount() == MAX_SHOE_SEATS);
+    while (table.current != MAX_SHOE_SEATS - 1) {
+        CHECK(full.bet(table.legal.minBet) == ActionStatus::OK);
+    }
+    CHECK(popcount64(table.legal.targets) == MAX_SHOE_SEATS - 1);
+    CHECK(full.bet(table.legal.minBet) == ActionStatus::OK);
+    CHECK(table.current == 0);
+
+    rejected = false;
+    try {
+        ShoeTableState tooMany = ShoeTableState();
+        tooMany.seatPlayers(MAX_SHOE_SEATS + 1, 1000);
+    } catch (const invalid_argument&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+}
+
+} // namespace
+
+int main() {
+    testMinimumBets();
+    testRoomMinimumBet();
+    testShowdownCost();
+    testShowdownAndSettlement();
+    testSpecial235AgainstLeopard();
+    testAgainstReference();
+    testShoeTables();
+    return testResult("TableStateTest");
+}
@@ -0,0 +1,37 @@
+//
+// Created for engine unit tests
+// 每个测试是一个独立的可执行文件：失败时打印位置和表达式，main返回非0
+//
+
+#ifndef POKERSERVER_TESTCHECK_H
+#define POKERSERVER_TESTCHECK_H
+
+#include <iostream>
+
+// 本测试程序累计的失败次数
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+// 检查失败时记录并继续，让一次运行报告尽可能多的问题
+#define CHECK(expr)                                                                  \
+    do {                                                                             \
+        if (!(expr)) {                                                               \
+            ++testFailures();                                                        \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #expr ") failed" \
+                      << std::endl;                                                  \
+        }                                                                            \
+    } while (0)
+
+// 测试程序的返回值
+inline int testResult(const char* name) {
+    if (testFailures() == 0) {
+        std::cout << name << ": OK" << std::endl;
+        return 0;
+    }
+    std::cerr << name << ": " << testFailures() << " failure(s)" << std::endl;
+    return 1;
+}
+
+#endif //POKERSERVER_TESTCHECK_H
@@ -0,0 +1,49 @@
+//
+// Created for thread pool tests
+// 连续多次parallelFor：每个任务恰好执行一次，迟醒的工作线程不能串到下一轮
+//
+
+#include "ThreadPool.h"
+#include "TestCheck.h"
+
+namespace {
+
+// 每轮任务数不同，迟醒的线程若读到上一轮的任务数会多执行或漏执行任务
+void testBackToBackCalls() {
+    ThreadPool pool(4);
+    for (int round = 0; round < 2000; ++round) {
+        int taskCount = 1 + round % 37;
+        vector<atomic<int>> hits(taskCount);
+        for (auto& hit : hits) {
+            hit.store(0);
+        }
+        atomic<int> badWorker(0);
+        pool.parallelFor(taskCount, [&](int task, int worker) {
+            hits[task].fetch_add(1);
+            if (worker < 0 || worker >= pool.size()) {
+                badWorker.fetch_add(1);
+            }
+        });
+        for (int task = 0; task < taskCount; ++task) {
+            CHECK(hits[task].load() == 1);
+        }
+        CHECK(badWorker.load() == 0);
+    }
+}
+
+void testEmptyAndSingleThread() {
+    ThreadPool single(1);
+    int sum = 0;
+    single.parallelFor(10, [&](int task, int worker) { sum += task + worker; });
+    CHECK(sum == 45);
+    single.parallelFor(0, [&](int, int) { sum = -1; });
+    CHECK(sum == 45);
+}
+
+} // namespace
+
+int main() {
+    testBackToBackCalls();
+    testEmptyAndSingleThread();
+    return testResult("ThreadPoolTest");
+}